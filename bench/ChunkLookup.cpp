@@ -0,0 +1,98 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include "utils/Random.h"
+#include "world/Level.h"
+
+static const int RENDER_DISTANCE = 12;
+static const int LOOKUPS         = 20000000;
+
+static BlockPos randomPos(Random &random)
+{
+    int limit = RENDER_DISTANCE * Chunk::SIZE_X;
+    return BlockPos(random.nextInt(-limit, limit + Chunk::SIZE_X - 1),
+                    random.nextInt(0, Chunk::SIZE_Y - 1),
+                    random.nextInt(-limit, limit + Chunk::SIZE_Z - 1));
+}
+
+static uint64_t walk(const Level &level, uint64_t seed, bool scattered)
+{
+    Random random(seed);
+    BlockPos pos = randomPos(random);
+    int limit    = RENDER_DISTANCE * Chunk::SIZE_X;
+
+    uint64_t sum = 0;
+    for (int i = 0; i < LOOKUPS; i++)
+    {
+        if (scattered)
+        {
+            pos = randomPos(random);
+        }
+        else
+        {
+            uint32_t step = random.nextUInt();
+            pos.x         = std::clamp(pos.x + (int) (step % 3) - 1, -limit, limit);
+            pos.y         = std::clamp(pos.y + (int) ((step >> 8) % 3) - 1, 0, Chunk::SIZE_Y - 1);
+            pos.z         = std::clamp(pos.z + (int) ((step >> 16) % 3) - 1, -limit, limit);
+        }
+        sum += level.getBlockId(pos);
+    }
+    return sum;
+}
+
+static void run(const Level &level, size_t threadCount, bool scattered)
+{
+    std::atomic<uint64_t> sum(0);
+    std::vector<std::thread> threads;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < threadCount; i++)
+    {
+        threads.emplace_back([&level, &sum, i, scattered] {
+            sum.fetch_add(walk(level, 0x9e3779b97f4a7c15ULL * (i + 1), scattered));
+        });
+    }
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+                        .count();
+
+    std::printf("%-10s threads %2zu  %8.2f ms  %7.2f Mlookup/s per thread  (checksum %llu)\n",
+                scattered ? "scattered" : "walk", threadCount, ms, LOOKUPS / ms / 1000.0,
+                (unsigned long long) sum.load());
+}
+
+int main(int argc, char **argv)
+{
+    size_t threadCount = argc > 1 ? (size_t) std::atoi(argv[1])
+                                  : (size_t) std::max(1u, std::thread::hardware_concurrency());
+
+    Level level(0);
+    level.setRenderDistance(RENDER_DISTANCE);
+    for (int cz = -RENDER_DISTANCE; cz <= RENDER_DISTANCE; cz++)
+    {
+        for (int cx = -RENDER_DISTANCE; cx <= RENDER_DISTANCE; cx++)
+        {
+            Chunk &chunk = level.createChunk(ChunkPos(cx, 0, cz));
+            chunk.fillColumn((cx + cz) & 15, (cx * cz) & 15, 0, 63, 1);
+        }
+    }
+
+    for (bool scattered : {false, true})
+    {
+        run(level, 1, scattered);
+        if (threadCount > 1)
+        {
+            run(level, threadCount, scattered);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,120 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "threading/MpscQueue.h"
+
+using Clock = std::chrono::steady_clock;
+
+class LockedQueue
+{
+public:
+    explicit LockedQueue(size_t) {}
+
+    void push(Clock::time_point &&item)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        m_items.push_back(item);
+    }
+
+    template<typename Container>
+    size_t drain(Container *out, size_t max)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        size_t count = 0;
+        while (count < max && !m_items.empty())
+        {
+            out->push_back(m_items.front());
+            m_items.pop_front();
+            count++;
+        }
+        return count;
+    }
+
+private:
+    std::deque<Clock::time_point> m_items;
+    std::mutex m_mutex;
+};
+
+template<typename Queue>
+static void runRound(const char *name, size_t producerCount, size_t messagesPerProducer,
+                     int intervalNanos)
+{
+    Queue queue(4096);
+    std::atomic<bool> go(false);
+
+    std::vector<std::thread> producers;
+    for (size_t p = 0; p < producerCount; p++)
+    {
+        producers.emplace_back([&queue, &go, messagesPerProducer, intervalNanos] {
+            while (!go.load(std::memory_order_acquire))
+            {
+                std::this_thread::yield();
+            }
+
+            Clock::time_point next = Clock::now();
+            for (size_t i = 0; i < messagesPerProducer; i++)
+            {
+                while (Clock::now() < next)
+                {
+                }
+                next += std::chrono::nanoseconds(intervalNanos);
+                queue.push(Clock::now());
+            }
+        });
+    }
+
+    std::vector<double> latencies;
+    latencies.reserve(producerCount * messagesPerProducer);
+    std::vector<Clock::time_point> batch;
+
+    Clock::time_point start = Clock::now();
+    go.store(true, std::memory_order_release);
+    while (latencies.size() < producerCount * messagesPerProducer)
+    {
+        batch.clear();
+        queue.drain(&batch, 256);
+
+        Clock::time_point now = Clock::now();
+        for (const Clock::time_point &pushed : batch)
+        {
+            latencies.push_back(std::chrono::duration<double, std::micro>(now - pushed).count());
+        }
+    }
+    double elapsed = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    for (std::thread &producer : producers)
+    {
+        producer.join();
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    size_t count = latencies.size();
+    std::printf("%-12s producers %2zu  interval %5d ns  %6.2f Mmsg/s  p50 %8.2f us  "
+                "p99 %8.2f us  max %9.2f us\n",
+                name, producerCount, intervalNanos, count / elapsed / 1000.0, latencies[count / 2],
+                latencies[count * 99 / 100], latencies.back());
+}
+
+int main(int argc, char **argv)
+{
+    size_t messages = argc > 1 ? (size_t) std::atoll(argv[1]) : 200000;
+
+    for (int interval : {0, 2000})
+    {
+        for (size_t producers : {1, 2, 4, 8})
+        {
+            runRound<LockedQueue>("locked deque", producers, messages, interval);
+            runRound<MpscQueue<Clock::time_point>>("mpsc queue", producers, messages, interval);
+        }
+    }
+    return 0;
+}
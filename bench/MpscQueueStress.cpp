@@ -0,0 +1,104 @@
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "threading/MpscQueue.h"
+
+struct Message
+{
+    size_t producer;
+    size_t sequence;
+    std::unique_ptr<size_t> payload;
+};
+
+static bool runRound(size_t producerCount, size_t messagesPerProducer, size_t capacity)
+{
+    MpscQueue<Message> queue(capacity);
+    std::atomic<bool> go(false);
+
+    std::vector<std::thread> producers;
+    for (size_t p = 0; p < producerCount; p++)
+    {
+        producers.emplace_back([&queue, &go, p, messagesPerProducer] {
+            while (!go.load(std::memory_order_acquire))
+            {
+                std::this_thread::yield();
+            }
+
+            for (size_t i = 0; i < messagesPerProducer; i++)
+            {
+                queue.push(Message{p, i, std::make_unique<size_t>(p * messagesPerProducer + i)});
+            }
+        });
+    }
+
+    std::vector<size_t> nextSequence(producerCount, 0);
+    std::vector<Message> batch;
+    size_t expected = producerCount * messagesPerProducer;
+    size_t received = 0;
+    size_t errors   = 0;
+
+    go.store(true, std::memory_order_release);
+    while (received < expected)
+    {
+        batch.clear();
+        Message message;
+        if ((received & 1) == 0 && queue.tryPop(&message))
+        {
+            batch.push_back(std::move(message));
+        }
+        queue.drain(&batch, 64);
+
+        for (const Message &item : batch)
+        {
+            size_t value = item.producer * messagesPerProducer + item.sequence;
+            if (item.producer >= producerCount || item.sequence != nextSequence[item.producer] ||
+                !item.payload || *item.payload != value)
+            {
+                errors++;
+                continue;
+            }
+            nextSequence[item.producer]++;
+        }
+        received += batch.size();
+
+        if (batch.empty())
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    for (std::thread &producer : producers)
+    {
+        producer.join();
+    }
+
+    if (!queue.empty())
+    {
+        errors++;
+    }
+
+    std::printf("producers %2zu  capacity %5zu  messages %8zu  errors %zu\n", producerCount,
+                capacity, received, errors);
+    return errors == 0;
+}
+
+int main(int argc, char **argv)
+{
+    size_t messages = argc > 1 ? (size_t) std::atoll(argv[1]) : 20000;
+
+    bool ok = true;
+    for (size_t producers : {1, 2, 4, 8})
+    {
+        for (size_t capacity : {2, 16, 1024})
+        {
+            ok = runRound(producers, messages, capacity) && ok;
+        }
+    }
+
+    std::printf("%s\n", ok ? "ok" : "FAILED");
+    return ok ? 0 : 1;
+}
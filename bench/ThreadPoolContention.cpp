@@ -0,0 +1,172 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+#include "threading/ThreadPool.h"
+
+class LockedPool
+{
+public:
+    explicit LockedPool(size_t threadCount) : m_pending(0), m_stopping(false)
+    {
+        for (size_t i = 0; i < threadCount; i++)
+        {
+            m_threads.emplace_back([this] { workerLoop(); });
+        }
+    }
+
+    ~LockedPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            m_stopping = true;
+        }
+
+        m_cv.notify_all();
+        for (std::thread &thread : m_threads)
+        {
+            thread.join();
+        }
+    }
+
+    void detachTask(std::function<void()> task)
+    {
+        m_pending.fetch_add(1);
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            m_tasks.push(task);
+        }
+        m_cv.notify_one();
+    }
+
+    void wait()
+    {
+        std::unique_lock<std::mutex> lock(m_waitMutex);
+
+        m_waitCv.wait(lock, [this] { return m_pending.load() == 0; });
+    }
+
+private:
+    void workerLoop()
+    {
+        while (true)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+
+                m_cv.wait(lock, [this] { return m_stopping || !m_tasks.empty(); });
+                if (m_tasks.empty())
+                {
+                    return;
+                }
+
+                task = std::move(m_tasks.front());
+                m_tasks.pop();
+            }
+
+            task();
+
+            if (m_pending.fetch_sub(1) == 1)
+            {
+                std::lock_guard<std::mutex> lock(m_waitMutex);
+                m_waitCv.notify_all();
+            }
+        }
+    }
+
+    std::vector<std::thread> m_threads;
+    std::queue<std::function<void()>> m_tasks;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::atomic<size_t> m_pending;
+    std::mutex m_waitMutex;
+    std::condition_variable m_waitCv;
+    bool m_stopping;
+};
+
+static void spin(int iterations)
+{
+    volatile int sink = 0;
+    for (int i = 0; i < iterations; i++)
+    {
+        sink = sink + i;
+    }
+}
+
+template<typename Pool>
+static double runFlat(Pool &pool, int taskCount, int work)
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < taskCount; i++)
+    {
+        pool.detachTask([work] { spin(work); });
+    }
+    pool.wait();
+
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+            .count();
+}
+
+template<typename Pool>
+static double runNested(Pool &pool, int parentCount, int childCount, int work)
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < parentCount; i++)
+    {
+        pool.detachTask([&pool, childCount, work] {
+            for (int j = 0; j < childCount; j++)
+            {
+                pool.detachTask([work] { spin(work); });
+            }
+        });
+    }
+    pool.wait();
+
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+            .count();
+}
+
+template<typename Pool>
+static void runSuite(const char *name, size_t threadCount, int work)
+{
+    const int flatTasks   = 200000;
+    const int parentTasks = 2000;
+    const int childTasks  = 100;
+
+    Pool pool(threadCount);
+    runFlat(pool, flatTasks / 10, work);
+
+    double flat   = runFlat(pool, flatTasks, work);
+    double nested = runNested(pool, parentTasks, childTasks, work);
+
+    std::printf("%-14s threads %2zu  work %4d  flat %8.2f ms (%6.2f Mtask/s)  "
+                "nested %8.2f ms (%6.2f Mtask/s)\n",
+                name, threadCount, work, flat, flatTasks / flat / 1000.0, nested,
+                (double) (parentTasks * (childTasks + 1)) / nested / 1000.0);
+}
+
+int main(int argc, char **argv)
+{
+    size_t threadCount = argc > 1 ? (size_t) std::atoi(argv[1])
+                                  : (size_t) std::max(2u, std::thread::hardware_concurrency());
+
+    for (int work : {0, 64, 1024})
+    {
+        runSuite<LockedPool>("locked queue", threadCount, work);
+        runSuite<ThreadPool>("work stealing", threadCount, work);
+    }
+    return 0;
+}
@@ -0,0 +1,62 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <unordered_map>
+
+#include "threading/ThreadStorage.h"
+
+static const int ITERATIONS = 20000000;
+
+struct BenchKey;
+
+using BenchSlot = ThreadStorage::Slot<BenchKey, uintptr_t>;
+
+static thread_local std::unordered_map<std::string, uintptr_t> s_mapStorage;
+static thread_local uintptr_t s_rawValue = 0;
+
+template<typename Function>
+static void measure(const char *name, Function &&function)
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    uintptr_t sum = 0;
+    for (int i = 0; i < ITERATIONS; i++)
+    {
+        sum += function((uintptr_t) i);
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+    }
+
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start)
+                        .count();
+    std::printf("%-22s %7.2f ns/access  (checksum %llu)\n", name, ns / ITERATIONS,
+                (unsigned long long) sum);
+}
+
+int main()
+{
+    const std::string key = "bench.value";
+
+    measure("string map (old)", [&key](uintptr_t i) {
+        s_mapStorage[key] = i;
+        return s_mapStorage.find(key)->second;
+    });
+
+    measure("string shim", [&key](uintptr_t i) {
+        ThreadStorage::setValue(key, i);
+        return ThreadStorage::getValue(key);
+    });
+
+    measure("typed slot", [](uintptr_t i) {
+        BenchSlot::set(i);
+        return BenchSlot::get();
+    });
+
+    measure("raw thread_local", [](uintptr_t i) {
+        s_rawValue = i;
+        return s_rawValue;
+    });
+
+    return 0;
+}
@@ -1,6 +1,7 @@
 #include "Minecraft.h"
 
 #include <cmath>
+#include <cstdlib>
 #include <memory>
 #include <stdexcept>
 
@@ -14,6 +15,7 @@
 #include "../rendering/GlStateManager.h"
 #include "../rendering/RenderCommand.h"
 #include "../rendering/Tesselator.h"
+#include "../threading/JobSystem.h"
 #include "../ui/ImGuiSystem.h"
 #include "../ui/scene/UIScene_DebugOverlay.h"
 #include "../ui/scene/UIScene_MainMenu.h"
@@ -113,6 +115,19 @@ Minecraft::Minecraft()
             {
                 m_levelRenderer->toggleGrassSideOverlay();
             }
+            else if ((event.getKey() == SDL_SCANCODE_LEFTBRACKET ||
+                      event.getKey() == SDL_SCANCODE_RIGHTBRACKET) &&
+                     m_level)
+            {
+                FrameBudget &frameBudget = m_level->getFrameBudget();
+                double step              = FrameBudget::BUDGET_STEP_MS;
+                if (event.getKey() == SDL_SCANCODE_LEFTBRACKET)
+                {
+                    step = -step;
+                }
+                frameBudget.setBudgetMillis(frameBudget.getBudgetMillis() + step);
+                Logger::logInfo("Frame budget: %.1f ms", frameBudget.getBudgetMillis());
+            }
             return true;
         });
 
@@ -185,6 +200,7 @@ Minecraft::Minecraft()
 
     setMouseLock(false);
 
+    JobSystem::init(std::getenv("MINECRAFT_PIN_THREADS") != nullptr);
     initRegistries();
 
     m_projection = Mat4::perspective(70.0 * (M_PI / 180.0), (double) m_width / (double) m_height,
@@ -266,7 +282,8 @@ void Minecraft::start()
 
         if (m_inWorld && m_chunkManager && m_localPlayer)
         {
-            m_chunkManager->update(m_localPlayer->getPosition());
+            m_chunkManager->update(m_localPlayer->getPosition(), m_localPlayer->getVelocity(),
+                                   m_localPlayer->getFront());
         }
         if (m_inWorld && m_level)
         {
@@ -327,6 +344,8 @@ void Minecraft::shutdown()
         m_level = nullptr;
     }
 
+    JobSystem::shutdown();
+
     m_localPlayer       = nullptr;
     m_debugOverlayScene = nullptr;
 
@@ -47,6 +47,8 @@ Vec3 Entity::getRenderPosition(float partialTicks) const
                 a.z + (b.z - a.z) * partialTicks);
 }
 
+const Vec3 &Entity::getVelocity() const { return m_velocity; }
+
 const Vec3 &Entity::getFront() const { return m_front; }
 
 float Entity::getYaw() const { return m_yaw; }
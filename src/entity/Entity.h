@@ -24,6 +24,7 @@ public:
     const Vec3 &getPosition() const;
     const Vec3 &getOldPosition() const;
     Vec3 getRenderPosition(float partialTicks) const;
+    const Vec3 &getVelocity() const;
 
     const Vec3 &getFront() const;
     float getYaw() const;
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+class CancellationToken
+{
+public:
+    CancellationToken() = default;
+
+    static CancellationToken create()
+    {
+        CancellationToken token;
+        token.m_cancelled = std::make_shared<std::atomic<bool>>(false);
+        return token;
+    }
+
+    void cancel() const
+    {
+        if (m_cancelled)
+        {
+            m_cancelled->store(true, std::memory_order_relaxed);
+        }
+    }
+
+    bool isCancelled() const
+    {
+        return m_cancelled && m_cancelled->load(std::memory_order_relaxed);
+    }
+
+    bool isValid() const { return m_cancelled != nullptr; }
+
+private:
+    std::shared_ptr<std::atomic<bool>> m_cancelled;
+};
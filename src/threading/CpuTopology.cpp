@@ -0,0 +1,234 @@
+#include "CpuTopology.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+static bool readLine(const std::string &path, std::string *out)
+{
+    std::ifstream file(path);
+    if (!file)
+    {
+        return false;
+    }
+    return (bool) std::getline(file, *out);
+}
+
+static bool readInt(const std::string &path, int *out)
+{
+    std::string line;
+    if (!readLine(path, &line))
+    {
+        return false;
+    }
+
+    try
+    {
+        *out = std::stoi(line);
+    }
+    catch (...)
+    {
+        return false;
+    }
+    return true;
+}
+
+static std::vector<int> parseCpuList(const std::string &list)
+{
+    std::vector<int> cpus;
+    std::stringstream stream(list);
+    std::string range;
+    while (std::getline(stream, range, ','))
+    {
+        if (range.empty())
+        {
+            continue;
+        }
+
+        try
+        {
+            size_t dash = range.find('-');
+            int first   = std::stoi(range.substr(0, dash));
+            int last    = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+            for (int cpu = first; cpu <= last; cpu++)
+            {
+                cpus.push_back(cpu);
+            }
+        }
+        catch (...)
+        {
+            return {};
+        }
+    }
+    return cpus;
+}
+
+CpuTopology::CpuTopology() : m_logicalCount(0), m_quota(0.0) {}
+
+CpuTopology CpuTopology::probe()
+{
+    CpuTopology topology;
+    topology.probeCores();
+    if (topology.m_cores.empty())
+    {
+        topology.fallback();
+    }
+    topology.probeQuota();
+    return topology;
+}
+
+void CpuTopology::probeCores()
+{
+#if defined(__linux__)
+    std::string online;
+    if (!readLine("/sys/devices/system/cpu/online", &online))
+    {
+        return;
+    }
+
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    bool haveAffinity = sched_getaffinity(0, sizeof(allowed), &allowed) == 0;
+
+    std::map<std::pair<int, int>, std::vector<int>> cores;
+    for (int cpu : parseCpuList(online))
+    {
+        if (haveAffinity && cpu < CPU_SETSIZE && !CPU_ISSET(cpu, &allowed))
+        {
+            continue;
+        }
+
+        std::string base = "/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/";
+        int package      = 0;
+        int core         = cpu;
+        readInt(base + "physical_package_id", &package);
+        readInt(base + "core_id", &core);
+
+        cores[{package, core}].push_back(cpu);
+        m_logicalCount++;
+    }
+
+    for (auto &[key, cpus] : cores)
+    {
+        m_cores.push_back({key.first, key.second, std::move(cpus)});
+    }
+
+    std::sort(m_cores.begin(), m_cores.end(),
+              [](const Core &a, const Core &b) { return a.cpus.front() < b.cpus.front(); });
+#endif
+}
+
+void CpuTopology::probeQuota()
+{
+#if defined(__linux__)
+    std::ifstream cgroups("/proc/self/cgroup");
+    std::string line;
+    std::string path;
+    while (std::getline(cgroups, line))
+    {
+        if (line.rfind("0::", 0) == 0)
+        {
+            path = line.substr(3);
+            break;
+        }
+    }
+
+    if (path.empty())
+    {
+        return;
+    }
+
+    while (true)
+    {
+        std::string max;
+        if (readLine("/sys/fs/cgroup" + (path == "/" ? "" : path) + "/cpu.max", &max))
+        {
+            std::stringstream stream(max);
+            std::string quota;
+            double period = 0.0;
+            stream >> quota >> period;
+            if (quota != "max" && period > 0.0)
+            {
+                try
+                {
+                    double cpus = std::stod(quota) / period;
+                    m_quota     = m_quota > 0.0 ? std::min(m_quota, cpus) : cpus;
+                }
+                catch (...)
+                {
+                }
+            }
+        }
+
+        if (path == "/" || path.empty())
+        {
+            break;
+        }
+
+        size_t slash = path.find_last_of('/');
+        path         = slash == 0 || slash == std::string::npos ? "/" : path.substr(0, slash);
+    }
+#endif
+}
+
+void CpuTopology::fallback()
+{
+    size_t count   = std::max(1u, std::thread::hardware_concurrency());
+    m_logicalCount = count;
+    for (size_t i = 0; i < count; i++)
+    {
+        m_cores.push_back({0, (int) i, {(int) i}});
+    }
+}
+
+const std::vector<CpuTopology::Core> &CpuTopology::getCores() const { return m_cores; }
+
+size_t CpuTopology::getLogicalCount() const { return m_logicalCount; }
+
+size_t CpuTopology::getPhysicalCount() const { return m_cores.size(); }
+
+double CpuTopology::getQuota() const { return m_quota; }
+
+size_t CpuTopology::getUsableCores() const
+{
+    size_t cores = std::max((size_t) 1, m_cores.size());
+    if (m_quota > 0.0)
+    {
+        cores = std::min(cores, (size_t) std::max(1.0, std::ceil(m_quota)));
+    }
+    return cores;
+}
+
+bool CpuTopology::pinCurrentThread(const std::vector<int> &cpus)
+{
+#if defined(__linux__)
+    if (cpus.empty())
+    {
+        return false;
+    }
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : cpus)
+    {
+        if (cpu >= 0 && cpu < CPU_SETSIZE)
+        {
+            CPU_SET(cpu, &set);
+        }
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void) cpus;
+    return false;
+#endif
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+class CpuTopology
+{
+public:
+    struct Core
+    {
+        int package;
+        int id;
+        std::vector<int> cpus;
+    };
+
+    static CpuTopology probe();
+
+    const std::vector<Core> &getCores() const;
+    size_t getLogicalCount() const;
+    size_t getPhysicalCount() const;
+    double getQuota() const;
+    size_t getUsableCores() const;
+
+    static bool pinCurrentThread(const std::vector<int> &cpus);
+
+private:
+    CpuTopology();
+
+    void probeCores();
+    void probeQuota();
+    void fallback();
+
+    std::vector<Core> m_cores;
+    size_t m_logicalCount;
+    double m_quota;
+};
@@ -0,0 +1,87 @@
+#include "JobCoroutine.h"
+
+#include <utility>
+
+JobTicket::JobTicket(int priority)
+    : m_jobClass(JobClass::GENERATION), m_jobId(0), m_priority(priority)
+{}
+
+void JobTicket::setPriority(int priority)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_priority.store(priority);
+    if (m_jobId != 0)
+    {
+        JobSystem::get()->setPriority(m_jobClass, m_jobId, priority);
+    }
+}
+
+int JobTicket::getPriority() const { return m_priority.load(); }
+
+ResumeOn::ResumeOn(JobClass jobClass, std::shared_ptr<JobTicket> ticket,
+                   const CancellationToken &token)
+    : m_jobClass(jobClass), m_ticket(std::move(ticket)), m_token(token)
+{}
+
+void ResumeOn::await_suspend(std::coroutine_handle<> handle)
+{
+    std::shared_ptr<JobTicket> ticket = m_ticket;
+    JobClass jobClass                 = m_jobClass;
+    CancellationToken token           = m_token;
+
+    uint64_t jobId;
+    if (ticket)
+    {
+        std::lock_guard<std::mutex> lock(ticket->m_mutex);
+
+        jobId = JobSystem::get()->submit(jobClass, [handle] { handle.resume(); },
+                                         ticket->m_priority.load(), token);
+        ticket->m_jobClass = jobClass;
+        ticket->m_jobId    = jobId;
+    }
+    else
+    {
+        jobId = JobSystem::get()->submit(jobClass, [handle] { handle.resume(); }, 0, token);
+    }
+
+    if (jobId == 0)
+    {
+        handle.resume();
+    }
+}
+
+JobEvent::JobEvent() : m_set(false) {}
+
+void JobEvent::set()
+{
+    std::vector<std::coroutine_handle<>> waiters;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_set.exchange(true))
+        {
+            return;
+        }
+        waiters.swap(m_waiters);
+    }
+
+    for (std::coroutine_handle<> waiter : waiters)
+    {
+        waiter.resume();
+    }
+}
+
+bool JobEvent::isSet() const { return m_set.load(); }
+
+bool JobEvent::Awaiter::await_suspend(std::coroutine_handle<> handle)
+{
+    std::lock_guard<std::mutex> lock(m_event->m_mutex);
+    if (m_event->m_set.load())
+    {
+        return false;
+    }
+
+    m_event->m_waiters.push_back(handle);
+    return true;
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <atomic>
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "CancellationToken.h"
+#include "JobSystem.h"
+
+class JobCoroutine
+{
+public:
+    struct promise_type
+    {
+        JobCoroutine get_return_object() { return JobCoroutine(); }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+class JobTicket
+{
+public:
+    explicit JobTicket(int priority = 0);
+
+    void setPriority(int priority);
+    int getPriority() const;
+
+private:
+    friend class ResumeOn;
+
+    std::mutex m_mutex;
+    JobClass m_jobClass;
+    uint64_t m_jobId;
+    std::atomic<int> m_priority;
+};
+
+class ResumeOn
+{
+public:
+    explicit ResumeOn(JobClass jobClass, std::shared_ptr<JobTicket> ticket = nullptr,
+                      const CancellationToken &token = CancellationToken());
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> handle);
+    void await_resume() const noexcept {}
+
+private:
+    JobClass m_jobClass;
+    std::shared_ptr<JobTicket> m_ticket;
+    CancellationToken m_token;
+};
+
+class JobEvent
+{
+public:
+    class Awaiter
+    {
+    public:
+        explicit Awaiter(JobEvent *event) : m_event(event) {}
+
+        bool await_ready() const { return m_event->isSet(); }
+        bool await_suspend(std::coroutine_handle<> handle);
+        void await_resume() const noexcept {}
+
+    private:
+        JobEvent *m_event;
+    };
+
+    JobEvent();
+
+    void set();
+    bool isSet() const;
+
+    Awaiter operator co_await() { return Awaiter(this); }
+
+private:
+    std::atomic<bool> m_set;
+    std::mutex m_mutex;
+    std::vector<std::coroutine_handle<>> m_waiters;
+};
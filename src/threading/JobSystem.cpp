@@ -0,0 +1,518 @@
+#include "JobSystem.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "../core/Logger.h"
+
+JobSystem::JobSystem()
+    : m_classes(), m_inFlight(0), m_nextJobId(1), m_dispatchRequested(false), m_virtualTime(0)
+{
+    for (ClassQueue &queue : m_classes)
+    {
+        queue.averageWaitMs = 0.0;
+        queue.averageRunMs  = 0.0;
+        queue.queued.store(0);
+        queue.running.store(0);
+        queue.cap.store(1);
+        queue.weight.store(1);
+        queue.completed.store(0);
+        queue.cancelled.store(0);
+        queue.pass = 0;
+        queue.idle = true;
+    }
+}
+
+JobSystem *JobSystem::get()
+{
+    static JobSystem instance;
+    return &instance;
+}
+
+void JobSystem::init(bool pinThreads)
+{
+    CpuTopology topology = CpuTopology::probe();
+    size_t usableCores   = topology.getUsableCores();
+    size_t threadCount   = std::max((size_t) 1, usableCores - 1);
+
+    Logger::logInfo("CPU topology: %d logical, %d physical, quota %.2f, %d usable cores",
+                    (int) topology.getLogicalCount(), (int) topology.getPhysicalCount(),
+                    topology.getQuota(), (int) usableCores);
+
+    get()->start(threadCount);
+    if (pinThreads)
+    {
+        get()->pin(topology);
+    }
+}
+
+void JobSystem::shutdown() { get()->stop(); }
+
+const char *JobSystem::getClassName(JobClass jobClass)
+{
+    switch (jobClass)
+    {
+    case JobClass::GENERATION:
+        return "generation";
+    case JobClass::MESHING:
+        return "meshing";
+    case JobClass::LIGHTING:
+        return "lighting";
+    case JobClass::SIMULATION:
+        return "simulation";
+    case JobClass::IO:
+        return "io";
+    default:
+        return "unknown";
+    }
+}
+
+void JobSystem::start(size_t threadCount)
+{
+    if (m_pool)
+    {
+        return;
+    }
+
+    m_pool = std::make_unique<ThreadPool>(threadCount);
+
+    setConcurrencyCap(JobClass::GENERATION, std::max((size_t) 1, threadCount - 1));
+    setConcurrencyCap(JobClass::MESHING, std::max((size_t) 1, (threadCount + 1) / 2));
+    setConcurrencyCap(JobClass::LIGHTING, std::max((size_t) 1, threadCount / 2));
+    setConcurrencyCap(JobClass::SIMULATION, 1);
+    setConcurrencyCap(JobClass::IO, 1);
+
+    setWeight(JobClass::GENERATION, 4);
+    setWeight(JobClass::MESHING, 4);
+    setWeight(JobClass::LIGHTING, 3);
+    setWeight(JobClass::SIMULATION, 2);
+    setWeight(JobClass::IO, 1);
+
+    Logger::logInfo("Starting job system with %d threads", (int) threadCount);
+}
+
+void JobSystem::pin(const CpuTopology &topology)
+{
+    const std::vector<CpuTopology::Core> &cores = topology.getCores();
+    if (!m_pool || cores.size() < 2)
+    {
+        Logger::logWarn("Not pinning job threads: need at least 2 physical cores");
+        return;
+    }
+
+    CpuTopology::pinCurrentThread(cores[0].cpus);
+    m_pool->runOnEachWorker([&cores](size_t index) {
+        CpuTopology::pinCurrentThread(cores[1 + index % (cores.size() - 1)].cpus);
+    });
+
+    Logger::logInfo("Pinned main thread to core 0 and %d job threads to cores 1-%d",
+                    (int) m_pool->getThreadCount(), (int) cores.size() - 1);
+}
+
+void JobSystem::stop()
+{
+    if (!m_pool)
+    {
+        return;
+    }
+
+    wait();
+
+    std::unique_ptr<ThreadPool> pool;
+    {
+        std::lock_guard<std::mutex> lock(m_dispatchMutex);
+        pool = std::move(m_pool);
+    }
+    pool.reset();
+
+    Logger::logInfo("Job system stopped");
+}
+
+uint64_t JobSystem::submit(JobClass jobClass, std::function<void()> job, int priority,
+                           const CancellationToken &token)
+{
+    if (!job || !m_pool)
+    {
+        return 0;
+    }
+
+    uint64_t id = enqueue(m_classes[(size_t) jobClass], std::move(job), priority, token);
+
+    dispatch();
+    return id;
+}
+
+JobSystem::Batch JobSystem::submitBatch(JobClass jobClass, std::span<std::function<void()>> jobs,
+                                        int priority, const CancellationToken &token)
+{
+    std::shared_ptr<BatchState> state = std::make_shared<BatchState>();
+    state->jobs.reserve(jobs.size());
+    for (std::function<void()> &job : jobs)
+    {
+        if (job)
+        {
+            state->jobs.push_back(std::move(job));
+        }
+    }
+
+    if (state->jobs.empty())
+    {
+        return Batch();
+    }
+
+    if (!m_pool)
+    {
+        runBatch(state.get());
+        return Batch(std::move(state));
+    }
+
+    size_t runners = std::min(state->jobs.size(), m_pool->getThreadCount());
+
+    ClassQueue &queue = m_classes[(size_t) jobClass];
+    for (size_t i = 0; i < runners; i++)
+    {
+        enqueue(queue, [state] { runBatch(state.get()); }, priority, token);
+    }
+
+    dispatch();
+    return Batch(std::move(state));
+}
+
+void JobSystem::parallelFor(JobClass jobClass, size_t begin, size_t end, size_t grain,
+                            const std::function<void(size_t, size_t)> &function, int priority)
+{
+    if (begin >= end || !function)
+    {
+        return;
+    }
+
+    grain = std::max((size_t) 1, grain);
+
+    std::vector<std::function<void()>> jobs;
+    jobs.reserve((end - begin + grain - 1) / grain);
+    for (size_t first = begin; first < end; first += grain)
+    {
+        size_t last = std::min(end, first + grain);
+        jobs.push_back([&function, first, last] { function(first, last); });
+    }
+
+    submitBatch(jobClass, jobs, priority).wait();
+}
+
+uint64_t JobSystem::enqueue(ClassQueue &queue, std::function<void()> job, int priority,
+                            const CancellationToken &token)
+{
+    uint64_t id = m_nextJobId.fetch_add(1);
+
+    std::lock_guard<std::mutex> lock(queue.mutex);
+
+    queue.jobs.push_back({std::move(job), Clock::now(), id, priority, token});
+    queue.positions[id] = queue.jobs.size() - 1;
+    siftUp(queue, queue.jobs.size() - 1);
+    queue.queued.fetch_add(1);
+    return id;
+}
+
+void JobSystem::siftUp(ClassQueue &queue, size_t index)
+{
+    while (index > 0)
+    {
+        size_t parent = (index - 1) / 2;
+        if (!JobCompare()(queue.jobs[parent], queue.jobs[index]))
+        {
+            break;
+        }
+        swapJobs(queue, parent, index);
+        index = parent;
+    }
+}
+
+void JobSystem::siftDown(ClassQueue &queue, size_t index)
+{
+    size_t count = queue.jobs.size();
+    while (true)
+    {
+        size_t largest = index;
+        size_t left    = index * 2 + 1;
+        size_t right   = left + 1;
+        if (left < count && JobCompare()(queue.jobs[largest], queue.jobs[left]))
+        {
+            largest = left;
+        }
+        if (right < count && JobCompare()(queue.jobs[largest], queue.jobs[right]))
+        {
+            largest = right;
+        }
+        if (largest == index)
+        {
+            break;
+        }
+        swapJobs(queue, largest, index);
+        index = largest;
+    }
+}
+
+void JobSystem::swapJobs(ClassQueue &queue, size_t a, size_t b)
+{
+    std::swap(queue.jobs[a], queue.jobs[b]);
+    queue.positions[queue.jobs[a].id] = a;
+    queue.positions[queue.jobs[b].id] = b;
+}
+
+void JobSystem::runBatch(BatchState *state)
+{
+    size_t count = state->jobs.size();
+    size_t index;
+    while ((index = state->next.fetch_add(1)) < count)
+    {
+        state->jobs[index]();
+        state->jobs[index] = nullptr;
+
+        if (state->done.fetch_add(1) + 1 == count)
+        {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            state->doneCv.notify_all();
+        }
+    }
+}
+
+void JobSystem::Batch::wait()
+{
+    if (!m_state)
+    {
+        return;
+    }
+
+    runBatch(m_state.get());
+
+    std::unique_lock<std::mutex> lock(m_state->mutex);
+    m_state->doneCv.wait(lock, [this] { return isDone(); });
+}
+
+bool JobSystem::Batch::isDone() const
+{
+    return !m_state || m_state->done.load() == m_state->jobs.size();
+}
+
+bool JobSystem::setPriority(JobClass jobClass, uint64_t jobId, int priority)
+{
+    ClassQueue &queue = m_classes[(size_t) jobClass];
+
+    std::lock_guard<std::mutex> lock(queue.mutex);
+
+    auto it = queue.positions.find(jobId);
+    if (it == queue.positions.end())
+    {
+        return false;
+    }
+
+    size_t index = it->second;
+    Job &job     = queue.jobs[index];
+    if (job.priority < priority)
+    {
+        job.priority = priority;
+        siftUp(queue, index);
+    }
+    else if (job.priority > priority)
+    {
+        job.priority = priority;
+        siftDown(queue, index);
+    }
+    return true;
+}
+
+void JobSystem::runOnEachWorker(const std::function<void(size_t)> &task)
+{
+    if (m_pool)
+    {
+        m_pool->runOnEachWorker(task);
+    }
+}
+
+void JobSystem::waitForClass(JobClass jobClass)
+{
+    std::unique_lock<std::mutex> lock(m_idleMutex);
+
+    const ClassQueue &queue = m_classes[(size_t) jobClass];
+    m_idleCv.wait(lock, [&queue] { return queue.queued.load() == 0 && queue.running.load() == 0; });
+}
+
+void JobSystem::wait()
+{
+    std::unique_lock<std::mutex> lock(m_idleMutex);
+
+    m_idleCv.wait(lock, [this] {
+        if (m_inFlight.load() != 0)
+        {
+            return false;
+        }
+        for (const ClassQueue &queue : m_classes)
+        {
+            if (queue.queued.load() != 0)
+            {
+                return false;
+            }
+        }
+        return true;
+    });
+}
+
+void JobSystem::setWeight(JobClass jobClass, uint32_t weight)
+{
+    m_classes[(size_t) jobClass].weight.store(std::max(1u, weight));
+}
+
+void JobSystem::setConcurrencyCap(JobClass jobClass, size_t cap)
+{
+    m_classes[(size_t) jobClass].cap.store(std::max((size_t) 1, cap));
+
+    dispatch();
+}
+
+size_t JobSystem::getConcurrencyCap(JobClass jobClass) const
+{
+    return m_classes[(size_t) jobClass].cap.load();
+}
+
+size_t JobSystem::getThreadCount() const { return m_pool ? m_pool->getThreadCount() : 0; }
+
+int JobSystem::getWorkerIndex() const { return m_pool ? m_pool->getWorkerIndex() : -1; }
+
+JobSystem::ClassStats JobSystem::getStats(JobClass jobClass) const
+{
+    const ClassQueue &queue = m_classes[(size_t) jobClass];
+
+    std::lock_guard<std::mutex> lock(queue.mutex);
+
+    return {queue.queued.load(),    queue.running.load(),   queue.cap.load(),
+            queue.completed.load(), queue.cancelled.load(), queue.averageWaitMs,
+            queue.averageRunMs};
+}
+
+void JobSystem::dispatch()
+{
+    m_dispatchRequested.store(true);
+    while (true)
+    {
+        std::unique_lock<std::mutex> lock(m_dispatchMutex, std::try_to_lock);
+        if (!lock.owns_lock())
+        {
+            return;
+        }
+
+        m_dispatchRequested.store(false);
+        dispatchQueued();
+        lock.unlock();
+
+        if (!m_dispatchRequested.load())
+        {
+            return;
+        }
+    }
+}
+
+void JobSystem::dispatchQueued()
+{
+    if (!m_pool)
+    {
+        return;
+    }
+
+    while (m_inFlight.load() < m_pool->getThreadCount())
+    {
+        ClassQueue *selected = nullptr;
+        size_t selectedIndex = 0;
+        for (size_t i = 0; i < m_classes.size(); i++)
+        {
+            ClassQueue &queue = m_classes[i];
+            size_t queued     = queue.queued.load();
+            size_t running    = queue.running.load();
+            if (queued == 0)
+            {
+                queue.idle = queue.idle || running == 0;
+                continue;
+            }
+            if (queue.idle)
+            {
+                queue.pass = std::max(queue.pass, m_virtualTime);
+                queue.idle = false;
+            }
+            if (running >= queue.cap.load())
+            {
+                continue;
+            }
+            if (!selected || queue.pass < selected->pass)
+            {
+                selected      = &queue;
+                selectedIndex = i;
+            }
+        }
+
+        if (!selected)
+        {
+            break;
+        }
+
+        Job job;
+        {
+            std::lock_guard<std::mutex> lock(selected->mutex);
+
+            job = std::move(selected->jobs.front());
+            selected->positions.erase(job.id);
+            if (selected->jobs.size() > 1)
+            {
+                selected->jobs.front() = std::move(selected->jobs.back());
+                selected->positions[selected->jobs.front().id] = 0;
+            }
+            selected->jobs.pop_back();
+            siftDown(*selected, 0);
+
+            selected->running.fetch_add(1);
+            selected->queued.fetch_sub(1);
+        }
+
+        m_inFlight.fetch_add(1);
+        if (job.token.isCancelled())
+        {
+            selected->cancelled.fetch_add(1);
+        }
+        else
+        {
+            m_virtualTime = selected->pass;
+            selected->pass += STRIDE / selected->weight.load();
+        }
+
+        JobClass jobClass = (JobClass) selectedIndex;
+        m_pool->detachTask([this, jobClass, job = std::move(job)] {
+            Clock::time_point start = Clock::now();
+            job.function();
+            Clock::time_point end = Clock::now();
+
+            finish(jobClass,
+                   std::chrono::duration<double, std::milli>(start - job.submitTime).count(),
+                   std::chrono::duration<double, std::milli>(end - start).count());
+        });
+    }
+}
+
+void JobSystem::finish(JobClass jobClass, double waitMs, double runMs)
+{
+    ClassQueue &queue = m_classes[(size_t) jobClass];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+
+        queue.averageWaitMs += (waitMs - queue.averageWaitMs) * 0.05;
+        queue.averageRunMs += (runMs - queue.averageRunMs) * 0.05;
+        queue.completed.fetch_add(1);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_idleMutex);
+
+        queue.running.fetch_sub(1);
+        m_inFlight.fetch_sub(1);
+    }
+
+    m_idleCv.notify_all();
+    dispatch();
+}
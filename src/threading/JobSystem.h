@@ -0,0 +1,168 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "CancellationToken.h"
+#include "CpuTopology.h"
+#include "ThreadPool.h"
+
+enum class JobClass : uint8_t
+{
+    GENERATION = 0,
+    MESHING    = 1,
+    LIGHTING   = 2,
+    SIMULATION = 3,
+    IO         = 4,
+    COUNT      = 5,
+};
+
+class JobSystem
+{
+public:
+    class Batch;
+
+    struct ClassStats
+    {
+        size_t queued;
+        size_t running;
+        size_t cap;
+        uint64_t completed;
+        uint64_t cancelled;
+        double averageWaitMs;
+        double averageRunMs;
+    };
+
+    static JobSystem *get();
+    static void init(bool pinThreads = false);
+    static void shutdown();
+
+    static const char *getClassName(JobClass jobClass);
+
+    uint64_t submit(JobClass jobClass, std::function<void()> job, int priority = 0,
+                    const CancellationToken &token = CancellationToken());
+    Batch submitBatch(JobClass jobClass, std::span<std::function<void()>> jobs,
+                      int priority = 0, const CancellationToken &token = CancellationToken());
+    void parallelFor(JobClass jobClass, size_t begin, size_t end, size_t grain,
+                     const std::function<void(size_t, size_t)> &function, int priority = 0);
+    bool setPriority(JobClass jobClass, uint64_t jobId, int priority);
+    void runOnEachWorker(const std::function<void(size_t)> &task);
+
+    void waitForClass(JobClass jobClass);
+    void wait();
+
+    void setWeight(JobClass jobClass, uint32_t weight);
+    void setConcurrencyCap(JobClass jobClass, size_t cap);
+    size_t getConcurrencyCap(JobClass jobClass) const;
+
+    size_t getThreadCount() const;
+    int getWorkerIndex() const;
+    ClassStats getStats(JobClass jobClass) const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Job
+    {
+        std::function<void()> function;
+        Clock::time_point submitTime;
+        uint64_t id;
+        int priority;
+        CancellationToken token;
+    };
+
+    struct JobCompare
+    {
+        bool operator()(const Job &a, const Job &b) const
+        {
+            if (a.priority != b.priority)
+                return a.priority < b.priority;
+            return a.id > b.id;
+        }
+    };
+
+    struct ClassQueue
+    {
+        mutable std::mutex mutex;
+        std::vector<Job> jobs;
+        std::unordered_map<uint64_t, size_t> positions;
+        double averageWaitMs;
+        double averageRunMs;
+
+        std::atomic<size_t> queued;
+        std::atomic<size_t> running;
+        std::atomic<size_t> cap;
+        std::atomic<uint32_t> weight;
+        std::atomic<uint64_t> completed;
+        std::atomic<uint64_t> cancelled;
+
+        uint64_t pass;
+        bool idle;
+    };
+
+    struct BatchState
+    {
+        std::vector<std::function<void()>> jobs;
+        std::atomic<size_t> next;
+        std::atomic<size_t> done;
+        mutable std::mutex mutex;
+        std::condition_variable doneCv;
+    };
+
+    static constexpr uint64_t STRIDE = 1 << 20;
+
+    JobSystem();
+
+    void start(size_t threadCount);
+    void pin(const CpuTopology &topology);
+    void stop();
+    void dispatch();
+    void dispatchQueued();
+    void finish(JobClass jobClass, double waitMs, double runMs);
+    uint64_t enqueue(ClassQueue &queue, std::function<void()> job, int priority,
+                     const CancellationToken &token);
+
+    static void runBatch(BatchState *state);
+    static void siftUp(ClassQueue &queue, size_t index);
+    static void siftDown(ClassQueue &queue, size_t index);
+    static void swapJobs(ClassQueue &queue, size_t a, size_t b);
+
+    std::unique_ptr<ThreadPool> m_pool;
+    std::array<ClassQueue, (size_t) JobClass::COUNT> m_classes;
+    std::atomic<size_t> m_inFlight;
+    std::atomic<uint64_t> m_nextJobId;
+
+    std::mutex m_dispatchMutex;
+    std::atomic<bool> m_dispatchRequested;
+    uint64_t m_virtualTime;
+
+    std::mutex m_idleMutex;
+    std::condition_variable m_idleCv;
+};
+
+class JobSystem::Batch
+{
+public:
+    Batch() = default;
+
+    void wait();
+    bool isDone() const;
+
+private:
+    friend class JobSystem;
+
+    explicit Batch(std::shared_ptr<BatchState> state) : m_state(std::move(state)) {}
+
+    std::shared_ptr<BatchState> m_state;
+};
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+template<typename T>
+class MpscQueue
+{
+public:
+    explicit MpscQueue(size_t capacity = 1024)
+        : m_capacity(roundUp(capacity)), m_mask(m_capacity - 1), m_cells(new Cell[m_capacity]),
+          m_head(0), m_tail(0)
+    {
+        for (size_t i = 0; i < m_capacity; i++)
+        {
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscQueue(const MpscQueue &)            = delete;
+    MpscQueue &operator=(const MpscQueue &) = delete;
+
+    bool tryPush(T &&item)
+    {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            Cell &cell      = m_cells[tail & m_mask];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            intptr_t diff   = (intptr_t) sequence - (intptr_t) tail;
+
+            if (diff == 0)
+            {
+                if (m_tail.compare_exchange_weak(tail, tail + 1, std::memory_order_relaxed))
+                {
+                    cell.value = std::move(item);
+                    cell.sequence.store(tail + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false;
+            }
+            else
+            {
+                tail = m_tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void push(T &&item)
+    {
+        while (!tryPush(std::move(item)))
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    bool tryPop(T *out)
+    {
+        size_t head = m_head.load(std::memory_order_relaxed);
+        Cell &cell  = m_cells[head & m_mask];
+        if (cell.sequence.load(std::memory_order_acquire) != head + 1)
+        {
+            return false;
+        }
+
+        *out = std::move(cell.value);
+        cell.sequence.store(head + m_capacity, std::memory_order_release);
+        m_head.store(head + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    template<typename Container>
+    size_t drain(Container *out, size_t max)
+    {
+        size_t head  = m_head.load(std::memory_order_relaxed);
+        size_t count = 0;
+        while (count < max)
+        {
+            Cell &cell = m_cells[head & m_mask];
+            if (cell.sequence.load(std::memory_order_acquire) != head + 1)
+            {
+                break;
+            }
+
+            out->push_back(std::move(cell.value));
+            cell.sequence.store(head + m_capacity, std::memory_order_release);
+            head++;
+            count++;
+        }
+
+        m_head.store(head, std::memory_order_relaxed);
+        return count;
+    }
+
+    void clear()
+    {
+        T item;
+        while (tryPop(&item))
+        {
+        }
+    }
+
+    size_t size() const
+    {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        size_t head = m_head.load(std::memory_order_relaxed);
+        return tail > head ? tail - head : 0;
+    }
+
+    bool empty() const { return size() == 0; }
+
+    size_t capacity() const { return m_capacity; }
+
+private:
+    struct Cell
+    {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    static size_t roundUp(size_t capacity)
+    {
+        size_t rounded = 2;
+        while (rounded < capacity)
+        {
+            rounded <<= 1;
+        }
+        return rounded;
+    }
+
+    size_t m_capacity;
+    size_t m_mask;
+    std::unique_ptr<Cell[]> m_cells;
+
+    alignas(64) std::atomic<size_t> m_head;
+    alignas(64) std::atomic<size_t> m_tail;
+};
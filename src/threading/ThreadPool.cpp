@@ -1,10 +1,18 @@
 #include "ThreadPool.h"
 
+#include <latch>
 #include <utility>
 
 #include "ThreadStorage.h"
 
-ThreadPool::ThreadPool(size_t threadCount) : m_stopping(false), m_activeWorkers(0)
+struct WorkerPoolKey;
+struct WorkerIndexKey;
+
+using WorkerPoolSlot  = ThreadStorage::Slot<WorkerPoolKey, const ThreadPool *>;
+using WorkerIndexSlot = ThreadStorage::Slot<WorkerIndexKey, int>;
+
+ThreadPool::ThreadPool(size_t threadCount)
+    : m_queued(0), m_pending(0), m_sleepers(0), m_stopping(false)
 {
     if (threadCount == 0)
     {
@@ -14,94 +22,181 @@ ThreadPool::ThreadPool(size_t threadCount) : m_stopping(false), m_activeWorkers(
     m_workers.reserve(threadCount);
     for (size_t i = 0; i < threadCount; i++)
     {
-        m_workers.emplace_back([this] { workerLoop(); });
+        m_workers.push_back(std::make_unique<Worker>());
+    }
+
+    for (size_t i = 0; i < threadCount; i++)
+    {
+        m_workers[i]->thread = std::thread([this, i] { workerLoop(i); });
     }
 }
 
 ThreadPool::~ThreadPool()
 {
     {
-        std::lock_guard<std::mutex> lock(m_mutex);
+        std::lock_guard<std::mutex> lock(m_parkMutex);
 
-        m_stopping = true;
+        m_stopping.store(true);
     }
 
-    m_taskCv.notify_all();
+    m_parkCv.notify_all();
 
-    for (std::thread &worker : m_workers)
+    for (std::unique_ptr<Worker> &worker : m_workers)
     {
-        if (worker.joinable())
+        if (worker->thread.joinable())
         {
-            worker.join();
+            worker->thread.join();
         }
     }
+
+    for (Task *task : m_injected)
+    {
+        delete task;
+    }
 }
 
 void ThreadPool::detachTask(std::function<void()> task)
 {
-    if (!task)
+    if (!task || m_stopping.load())
     {
         return;
     }
 
+    Task *owned = new Task(std::move(task));
+    m_pending.fetch_add(1);
+    m_queued.fetch_add(1);
+
+    int index = getWorkerIndex();
+    if (index >= 0)
+    {
+        m_workers[(size_t) index]->tasks.push(owned);
+    }
+    else
     {
-        std::lock_guard<std::mutex> lock(m_mutex);
+        std::lock_guard<std::mutex> lock(m_injectMutex);
 
-        if (m_stopping)
-        {
-            return;
-        }
+        m_injected.push_back(owned);
+    }
 
-        m_tasks.push(task);
+    unpark();
+}
+
+void ThreadPool::runOnEachWorker(const std::function<void(size_t)> &task)
+{
+    if (!task)
+    {
+        return;
+    }
+
+    std::latch started((std::ptrdiff_t) m_workers.size());
+    std::latch finished((std::ptrdiff_t) m_workers.size());
+
+    for (size_t i = 0; i < m_workers.size(); i++)
+    {
+        detachTask([this, &task, &started, &finished] {
+            started.arrive_and_wait();
+            task((size_t) getWorkerIndex());
+            finished.count_down();
+        });
     }
 
-    m_taskCv.notify_one();
+    finished.wait();
 }
 
 void ThreadPool::wait()
 {
-    std::unique_lock<std::mutex> lock(m_mutex);
+    std::unique_lock<std::mutex> lock(m_waitMutex);
 
-    m_waitCv.wait(lock, [this] { return m_tasks.empty() && m_activeWorkers == 0; });
+    m_waitCv.wait(lock, [this] { return m_pending.load() == 0; });
 }
 
 size_t ThreadPool::getThreadCount() const { return m_workers.size(); }
 
-void ThreadPool::workerLoop()
+int ThreadPool::getWorkerIndex() const
+{
+    return WorkerPoolSlot::get(nullptr) == this ? WorkerIndexSlot::get(-1) : -1;
+}
+
+void ThreadPool::workerLoop(size_t index)
 {
-    ThreadStorage::createNewThreadStorage();
+    WorkerPoolSlot::set(this);
+    WorkerIndexSlot::set((int) index);
 
     while (true)
     {
-        std::function<void()> task;
-
+        Task *task = findTask(index);
+        if (!task)
         {
-            std::unique_lock<std::mutex> lock(m_mutex);
-
-            m_taskCv.wait(lock, [this] { return m_stopping || !m_tasks.empty(); });
-
-            if (m_stopping && m_tasks.empty())
+            if (m_stopping.load() && m_queued.load() == 0)
             {
                 break;
             }
 
-            task = std::move(m_tasks.front());
-            m_tasks.pop();
-            m_activeWorkers++;
+            park();
+            continue;
         }
 
-        task();
+        m_queued.fetch_sub(1);
+        (*task)();
+        delete task;
 
+        if (m_pending.fetch_sub(1) == 1)
         {
-            std::lock_guard<std::mutex> lock(m_mutex);
-
-            m_activeWorkers--;
-            if (m_tasks.empty() && m_activeWorkers == 0)
-            {
-                m_waitCv.notify_all();
-            }
+            std::lock_guard<std::mutex> lock(m_waitMutex);
+            m_waitCv.notify_all();
         }
     }
 
     ThreadStorage::releaseThreadStorage();
 }
+
+ThreadPool::Task *ThreadPool::findTask(size_t index)
+{
+    Task *task = nullptr;
+    if (m_workers[index]->tasks.pop(&task))
+    {
+        return task;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_injectMutex);
+
+        if (!m_injected.empty())
+        {
+            task = m_injected.front();
+            m_injected.pop_front();
+            return task;
+        }
+    }
+
+    size_t count = m_workers.size();
+    for (size_t i = 1; i < count; i++)
+    {
+        if (m_workers[(index + i) % count]->tasks.steal(&task))
+        {
+            return task;
+        }
+    }
+
+    return nullptr;
+}
+
+void ThreadPool::park()
+{
+    std::unique_lock<std::mutex> lock(m_parkMutex);
+
+    m_sleepers.fetch_add(1);
+    m_parkCv.wait(lock, [this] { return m_stopping.load() || m_queued.load() > 0; });
+    m_sleepers.fetch_sub(1);
+}
+
+void ThreadPool::unpark()
+{
+    if (m_sleepers.load() == 0)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_parkMutex);
+    m_parkCv.notify_one();
+}
@@ -1,13 +1,17 @@
 #pragma once
 
+#include <atomic>
 #include <condition_variable>
 #include <cstddef>
+#include <deque>
 #include <functional>
+#include <memory>
 #include <mutex>
-#include <queue>
 #include <thread>
 #include <vector>
 
+#include "WorkStealingDeque.h"
+
 class ThreadPool
 {
 public:
@@ -21,22 +25,41 @@ public:
     ThreadPool &operator=(ThreadPool &&) = delete;
 
     void detachTask(std::function<void()> task);
+    void runOnEachWorker(const std::function<void(size_t)> &task);
 
     void wait();
 
     size_t getThreadCount() const;
+    int getWorkerIndex() const;
 
 private:
-    void workerLoop();
+    using Task = std::function<void()>;
+
+    struct Worker
+    {
+        WorkStealingDeque<Task *> tasks;
+        std::thread thread;
+    };
+
+    void workerLoop(size_t index);
+    Task *findTask(size_t index);
+    void park();
+    void unpark();
+
+    std::vector<std::unique_ptr<Worker>> m_workers;
+
+    std::deque<Task *> m_injected;
+    std::mutex m_injectMutex;
 
-    std::vector<std::thread> m_workers;
+    std::atomic<size_t> m_queued;
+    std::atomic<size_t> m_pending;
+    std::atomic<size_t> m_sleepers;
 
-    std::queue<std::function<void()>> m_tasks;
+    std::mutex m_parkMutex;
+    std::condition_variable m_parkCv;
 
-    mutable std::mutex m_mutex;
-    std::condition_variable m_taskCv;
+    std::mutex m_waitMutex;
     std::condition_variable m_waitCv;
 
-    bool m_stopping;
-    size_t m_activeWorkers;
+    std::atomic<bool> m_stopping;
 };
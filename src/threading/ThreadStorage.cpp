@@ -1,42 +1,94 @@
 #include "ThreadStorage.h"
 
-#include <memory>
+#include <cstdlib>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
 
-static thread_local std::unique_ptr<ThreadStorage::Storage> s_threadStorage;
+#include "../core/Logger.h"
 
-ThreadStorage::Storage *ThreadStorage::createNewThreadStorage()
+static std::unordered_map<std::string, size_t> s_namedSlots;
+static std::shared_mutex s_namedSlotsMutex;
+static thread_local std::unordered_map<std::string, size_t> s_knownNamedSlots;
+
+std::atomic<size_t> ThreadStorage::s_slotCount{0};
+
+size_t ThreadStorage::registerSlot()
 {
-    s_threadStorage = std::make_unique<Storage>();
-    return s_threadStorage.get();
+    size_t index = s_slotCount.fetch_add(1);
+    if (index >= MAX_SLOTS)
+    {
+        Logger::logError("Thread storage slot limit of %d exceeded", (int) MAX_SLOTS);
+        std::abort();
+    }
+    return index;
 }
 
-ThreadStorage::Storage *ThreadStorage::useDefaultThreadStorage()
+size_t ThreadStorage::findNamedSlot(const std::string &key, bool create)
 {
-    if (!s_threadStorage)
+    auto known = s_knownNamedSlots.find(key);
+    if (known != s_knownNamedSlots.end())
     {
-        s_threadStorage = std::make_unique<Storage>();
+        return known->second;
     }
-    return s_threadStorage.get();
+
+    size_t index = MAX_SLOTS;
+    {
+        std::shared_lock<std::shared_mutex> lock(s_namedSlotsMutex);
+
+        auto it = s_namedSlots.find(key);
+        if (it != s_namedSlots.end())
+        {
+            index = it->second;
+        }
+    }
+
+    if (index == MAX_SLOTS)
+    {
+        if (!create)
+        {
+            return MAX_SLOTS;
+        }
+
+        std::unique_lock<std::shared_mutex> lock(s_namedSlotsMutex);
+
+        auto it = s_namedSlots.find(key);
+        index   = it != s_namedSlots.end() ? it->second : registerSlot();
+        s_namedSlots.emplace(key, index);
+    }
+
+    s_knownNamedSlots.emplace(key, index);
+    return index;
+}
+
+size_t ThreadStorage::getSlotCount() { return s_slotCount.load(); }
+
+ThreadStorage::Storage *ThreadStorage::createNewThreadStorage()
+{
+    s_storage.present = 0;
+    return &s_storage;
 }
 
-void ThreadStorage::releaseThreadStorage() { s_threadStorage.reset(); }
+ThreadStorage::Storage *ThreadStorage::useDefaultThreadStorage() { return &s_storage; }
+
+void ThreadStorage::releaseThreadStorage() { s_storage.present = 0; }
 
-ThreadStorage::Storage *ThreadStorage::getStorage() { return s_threadStorage.get(); }
+ThreadStorage::Storage *ThreadStorage::getStorage() { return &s_storage; }
 
 void ThreadStorage::setValue(const std::string &key, uintptr_t value)
 {
-    Storage *storage     = useDefaultThreadStorage();
-    storage->values[key] = value;
+    size_t index           = findNamedSlot(key, true);
+    s_storage.slots[index] = value;
+    s_storage.present |= 1ull << index;
 }
 
 uintptr_t ThreadStorage::getValue(const std::string &key, uintptr_t defaultValue)
 {
-    Storage *storage = useDefaultThreadStorage();
-    auto it          = storage->values.find(key);
-    if (it == storage->values.end())
+    size_t index = findNamedSlot(key, false);
+    if (index >= MAX_SLOTS || !(s_storage.present & (1ull << index)))
     {
         return defaultValue;
     }
 
-    return it->second;
+    return s_storage.slots[index];
 }
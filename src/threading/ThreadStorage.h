@@ -1,15 +1,24 @@
 #pragma once
 
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <string>
-#include <unordered_map>
+#include <type_traits>
 
 class ThreadStorage
 {
 public:
+    static constexpr size_t MAX_SLOTS = 64;
+
+    template<typename Key, typename T>
+    class Slot;
+
     struct Storage
     {
-        std::unordered_map<std::string, uintptr_t> values;
+        uint64_t present;
+        uintptr_t slots[MAX_SLOTS];
     };
 
     static Storage *createNewThreadStorage();
@@ -20,4 +29,50 @@ public:
 
     static void setValue(const std::string &key, uintptr_t value);
     static uintptr_t getValue(const std::string &key, uintptr_t defaultValue = 0);
+
+    static size_t getSlotCount();
+
+private:
+    static size_t registerSlot();
+    static size_t findNamedSlot(const std::string &key, bool create);
+
+    static inline thread_local Storage s_storage{};
+    static std::atomic<size_t> s_slotCount;
+};
+
+template<typename Key, typename T>
+class ThreadStorage::Slot
+{
+    static_assert(std::is_trivially_copyable_v<T> && sizeof(T) <= sizeof(uintptr_t),
+                  "thread storage slots hold pointer-sized trivially copyable values");
+
+public:
+    static T get(T defaultValue = T())
+    {
+        const Storage &storage = s_storage;
+        if (!(storage.present & (1ull << s_index)))
+        {
+            return defaultValue;
+        }
+
+        T value;
+        std::memcpy(&value, &storage.slots[s_index], sizeof(T));
+        return value;
+    }
+
+    static void set(T value)
+    {
+        Storage &storage = s_storage;
+        uintptr_t raw    = 0;
+        std::memcpy(&raw, &value, sizeof(T));
+        storage.slots[s_index] = raw;
+        storage.present |= 1ull << s_index;
+    }
+
+    static void reset() { s_storage.present &= ~(1ull << s_index); }
+
+    static size_t getIndex() { return s_index; }
+
+private:
+    static inline const size_t s_index = registerSlot();
 };
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+template<typename T>
+class WorkStealingDeque
+{
+public:
+    explicit WorkStealingDeque(int64_t capacity = 256)
+        : m_top(0), m_bottom(0), m_array(new Array(capacity))
+    {
+        m_arrays.emplace_back(m_array.load(std::memory_order_relaxed));
+    }
+
+    WorkStealingDeque(const WorkStealingDeque &)            = delete;
+    WorkStealingDeque &operator=(const WorkStealingDeque &) = delete;
+
+    void push(T item)
+    {
+        int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+        int64_t top    = m_top.load(std::memory_order_acquire);
+        Array *array   = m_array.load(std::memory_order_relaxed);
+
+        if (bottom - top > array->capacity - 1)
+        {
+            array = grow(array, top, bottom);
+        }
+
+        array->put(bottom, item);
+        std::atomic_thread_fence(std::memory_order_release);
+        m_bottom.store(bottom + 1, std::memory_order_relaxed);
+    }
+
+    bool pop(T *out)
+    {
+        int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+        Array *array   = m_array.load(std::memory_order_relaxed);
+        m_bottom.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t top = m_top.load(std::memory_order_relaxed);
+
+        if (top > bottom)
+        {
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            return false;
+        }
+
+        T item = array->get(bottom);
+        if (top == bottom)
+        {
+            bool won = m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                                     std::memory_order_relaxed);
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            if (!won)
+            {
+                return false;
+            }
+        }
+
+        *out = item;
+        return true;
+    }
+
+    bool steal(T *out)
+    {
+        int64_t top = m_top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t bottom = m_bottom.load(std::memory_order_acquire);
+
+        if (top >= bottom)
+        {
+            return false;
+        }
+
+        Array *array = m_array.load(std::memory_order_acquire);
+        T item       = array->get(top);
+        if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                           std::memory_order_relaxed))
+        {
+            return false;
+        }
+
+        *out = item;
+        return true;
+    }
+
+    bool empty() const
+    {
+        int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+        int64_t top    = m_top.load(std::memory_order_relaxed);
+        return top >= bottom;
+    }
+
+private:
+    struct Array
+    {
+        explicit Array(int64_t capacity)
+            : capacity(capacity), mask(capacity - 1), data(new std::atomic<T>[capacity])
+        {}
+
+        T get(int64_t index) const { return data[index & mask].load(std::memory_order_relaxed); }
+
+        void put(int64_t index, T item)
+        {
+            data[index & mask].store(item, std::memory_order_relaxed);
+        }
+
+        int64_t capacity;
+        int64_t mask;
+        std::unique_ptr<std::atomic<T>[]> data;
+    };
+
+    Array *grow(Array *array, int64_t top, int64_t bottom)
+    {
+        Array *grown = new Array(array->capacity * 2);
+        for (int64_t i = top; i < bottom; i++)
+        {
+            grown->put(i, array->get(i));
+        }
+
+        m_arrays.emplace_back(grown);
+        m_array.store(grown, std::memory_order_release);
+        return grown;
+    }
+
+    std::atomic<int64_t> m_top;
+    std::atomic<int64_t> m_bottom;
+    std::atomic<Array *> m_array;
+    std::vector<std::unique_ptr<Array>> m_arrays;
+};
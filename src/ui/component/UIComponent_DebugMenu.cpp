@@ -15,6 +15,7 @@
 #include "../../rendering/Font.h"
 #include "../../rendering/GlStateManager.h"
 #include "../../rendering/Tesselator.h"
+#include "../../threading/JobSystem.h"
 #include "../../utils/Time.h"
 #include "../../utils/math/Mth.h"
 #include "../../world/Level.h"
@@ -466,10 +467,10 @@ void UIComponent_DebugMenu::refreshLines()
                 swprintf(buffer, 0xFF, L"grass side overlay: %ls  (G to toggle)", grassOverlay);
                 lines.emplace_back(buffer);
 
-                swprintf(buffer, 0xFF, L"mesher: upload %u  rebuild %u  urgent %u  sky %u",
+                swprintf(buffer, 0xFF, L"mesher: upload %u  active %u  deferred %u  sky %u",
                          (uint32_t) levelRenderer->getPendingMeshCount(),
-                         (uint32_t) levelRenderer->getQueuedRebuildCount(),
-                         (uint32_t) levelRenderer->getUrgentRebuildCount(),
+                         (uint32_t) levelRenderer->getActiveRebuildCount(),
+                         (uint32_t) levelRenderer->getDeferredRebuildCount(),
                          (uint32_t) levelRenderer->getSkyQueueCount());
                 lines.emplace_back(buffer);
 
@@ -489,6 +490,18 @@ void UIComponent_DebugMenu::refreshLines()
                 lines.emplace_back(buffer);
             }
 
+            for (size_t i = 0; i < (size_t) JobClass::COUNT; i++)
+            {
+                JobClass jobClass           = (JobClass) i;
+                JobSystem::ClassStats stats = JobSystem::get()->getStats(jobClass);
+                swprintf(buffer, 0xFF,
+                         L"jobs %s: queued %u  running %u/%u  cancel %u  wait %.2fms  run %.2fms",
+                         JobSystem::getClassName(jobClass), (uint32_t) stats.queued,
+                         (uint32_t) stats.running, (uint32_t) stats.cap,
+                         (uint32_t) stats.cancelled, stats.averageWaitMs, stats.averageRunMs);
+                lines.emplace_back(buffer);
+            }
+
             swprintf(buffer, 0xFF, L"level q: dirty %u  urgent %u  light %u  entities %u",
                      (uint32_t) level->getQueuedDirtyChunkCount(),
                      (uint32_t) level->getUrgentDirtyChunkCount(),
@@ -496,6 +509,10 @@ void UIComponent_DebugMenu::refreshLines()
                      (uint32_t) level->getEntities().size());
             lines.emplace_back(buffer);
 
+            swprintf(buffer, 0xFF, L"frame budget: %.1fms  ([ and ] to adjust)",
+                     level->getFrameBudget().getBudgetMillis());
+            lines.emplace_back(buffer);
+
             lines.emplace_back(L"");
 
             HitResult *result = level->clip(pos.add(Vec3(0.0, 1.6, 0.0)), front, 8.0f);
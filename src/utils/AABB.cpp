@@ -1,7 +1,5 @@
 #include "AABB.h"
 
-#include "../threading/ThreadStorage.h"
-
 AABB::AABB() : m_min(0.0, 0.0, 0.0), m_max(0.0, 0.0, 0.0) {}
 
 AABB::AABB(const Vec3 &min, const Vec3 &max) : m_min(min), m_max(max) {}
@@ -23,8 +21,6 @@ AABB AABB::translated(const Vec3 &offset) const
 
 bool AABB::intersects(const AABB &other) const
 {
-    ThreadStorage::useDefaultThreadStorage();
-
     if (m_max.x <= other.m_min.x || m_min.x >= other.m_max.x)
     {
         return false;
@@ -42,8 +38,6 @@ bool AABB::intersects(const AABB &other) const
 
 bool AABB::contains(const Vec3 &point) const
 {
-    ThreadStorage::useDefaultThreadStorage();
-
     if (point.x < m_min.x || point.x > m_max.x)
     {
         return false;
@@ -1,11 +1,18 @@
 #include "Direction.h"
 
-Direction::Direction(const char *name, int dx, int dy, int dz) : name(name), dx(dx), dy(dy), dz(dz)
+Direction::Direction(const char *name, int ordinal, int dx, int dy, int dz)
+    : name(name), ordinal(ordinal), dx(dx), dy(dy), dz(dz)
 {}
 
-Direction *Direction::NORTH = new Direction("north", 0, 0, -1);
-Direction *Direction::SOUTH = new Direction("south", 0, 0, 1);
-Direction *Direction::EAST  = new Direction("east", 1, 0, 0);
-Direction *Direction::WEST  = new Direction("west", -1, 0, 0);
-Direction *Direction::UP    = new Direction("up", 0, 1, 0);
-Direction *Direction::DOWN  = new Direction("down", 0, -1, 0);
+Direction *Direction::NORTH = new Direction("north", 0, 0, 0, -1);
+Direction *Direction::SOUTH = new Direction("south", 1, 0, 0, 1);
+Direction *Direction::EAST  = new Direction("east", 2, 1, 0, 0);
+Direction *Direction::WEST  = new Direction("west", 3, -1, 0, 0);
+Direction *Direction::UP    = new Direction("up", 4, 0, 1, 0);
+Direction *Direction::DOWN  = new Direction("down", 5, 0, -1, 0);
+
+Direction *Direction::byOrdinal(int ordinal)
+{
+    static Direction *const values[COUNT] = {NORTH, SOUTH, EAST, WEST, UP, DOWN};
+    return values[ordinal];
+}
@@ -5,9 +5,12 @@
 class Direction
 {
 public:
-    Direction(const char *name, int dx, int dy, int dz);
+    static constexpr int COUNT = 6;
+
+    Direction(const char *name, int ordinal, int dx, int dy, int dz);
 
     const std::string name;
+    int ordinal;
     int dx;
     int dy;
     int dz;
@@ -18,4 +21,6 @@ public:
     static Direction *WEST;
     static Direction *UP;
     static Direction *DOWN;
+
+    static Direction *byOrdinal(int ordinal);
 };
@@ -13,6 +13,7 @@ public:
     {
         uint32_t id      = (uint32_t) m_values.size();
         m_nameToId[name] = id;
+        m_valueToId.emplace(value, id);
         m_values.push_back(value);
         return id;
     }
@@ -37,14 +38,8 @@ public:
 
     uint32_t idOf(T value) const
     {
-        for (uint32_t i = 0; i < (uint32_t) m_values.size(); i++)
-        {
-            if (m_values[i] == value)
-            {
-                return i;
-            }
-        }
-        return 0;
+        auto it = m_valueToId.find(value);
+        return it == m_valueToId.end() ? 0 : it->second;
     }
 
     uint32_t getId(const std::string &name) const { return m_nameToId.at(name); }
@@ -55,5 +50,6 @@ public:
 
 private:
     std::unordered_map<std::string, uint32_t> m_nameToId;
+    std::unordered_map<T, uint32_t> m_valueToId;
     std::vector<T> m_values;
 };
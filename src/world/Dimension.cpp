@@ -4,9 +4,13 @@
 
 #include "../core/Logger.h"
 #include "../utils/math/Mth.h"
-#include "block/Block.h"
+#include "block/BlockProperties.h"
+#include "chunk/RegionView.h"
 
-Dimension::Dimension() : m_emptyChunksSolid(true), m_renderDistance(16) {}
+Dimension::Dimension() : m_emptyChunksSolid(true), m_renderDistance(16)
+{
+    m_chunkCache.rebuild(m_renderDistance + CACHE_MARGIN, m_chunks);
+}
 
 Chunk *Dimension::getChunk(const ChunkPos &pos)
 {
@@ -14,6 +18,12 @@ Chunk *Dimension::getChunk(const ChunkPos &pos)
     {
         return cached;
     }
+    if (!m_chunkCache.hasOverflow())
+    {
+        return nullptr;
+    }
+
+    std::shared_lock<std::shared_mutex> lock(m_chunksMutex);
 
     auto it = m_chunks.find(pos);
     if (it == m_chunks.end())
@@ -21,12 +31,22 @@ Chunk *Dimension::getChunk(const ChunkPos &pos)
         return nullptr;
     }
 
-    m_chunkCache.put(pos, it->second.get());
     return it->second.get();
 }
 
 const Chunk *Dimension::getChunk(const ChunkPos &pos) const
 {
+    if (Chunk *cached = m_chunkCache.get(pos))
+    {
+        return cached;
+    }
+    if (!m_chunkCache.hasOverflow())
+    {
+        return nullptr;
+    }
+
+    std::shared_lock<std::shared_mutex> lock(m_chunksMutex);
+
     auto it = m_chunks.find(pos);
     if (it == m_chunks.end())
     {
@@ -47,7 +67,10 @@ Chunk &Dimension::createChunk(const ChunkPos &pos)
     std::unique_ptr<Chunk> chunk = std::make_unique<Chunk>(pos);
     Chunk &ref                   = *chunk;
 
-    m_chunks.emplace(pos, std::move(chunk));
+    {
+        std::unique_lock<std::shared_mutex> lock(m_chunksMutex);
+        m_chunks.emplace(pos, std::move(chunk));
+    }
     m_chunkCache.put(pos, &ref);
 
     Logger::logInfo("Created chunk (%d, %d, %d)", pos.x, pos.y, pos.z);
@@ -62,17 +85,63 @@ bool Dimension::adoptChunk(const ChunkPos &pos, std::unique_ptr<Chunk> chunk)
         return false;
     }
 
-    auto [it, inserted] = m_chunks.emplace(pos, std::move(chunk));
-    if (!inserted)
+    Chunk *adopted;
+
+    {
+        std::unique_lock<std::shared_mutex> lock(m_chunksMutex);
+
+        auto [it, inserted] = m_chunks.emplace(pos, std::move(chunk));
+        if (!inserted)
+        {
+            return false;
+        }
+        adopted = it->second.get();
+    }
+
+    m_chunkCache.put(pos, adopted);
+    return true;
+}
+
+std::unique_ptr<Chunk> Dimension::removeChunk(const ChunkPos &pos)
+{
+    auto it = m_chunks.find(pos);
+    if (it == m_chunks.end())
+    {
+        return nullptr;
+    }
+
+    std::unique_ptr<Chunk> chunk;
+    {
+        std::unique_lock<std::shared_mutex> lock(m_chunksMutex);
+        chunk = std::move(it->second);
+        m_chunks.erase(it);
+    }
+    m_chunkCache.erase(pos);
+    return chunk;
+}
+
+bool Dimension::hasChunk(const ChunkPos &pos) const { return getChunk(pos) != nullptr; }
+
+bool Dimension::readChunk(const ChunkPos &pos,
+                          const std::function<void(const Chunk &)> &reader) const
+{
+    std::shared_lock<std::shared_mutex> lightLock(m_lightMutex);
+    std::shared_lock<std::shared_mutex> lock(m_chunksMutex);
+
+    auto it = m_chunks.find(pos);
+    if (it == m_chunks.end())
     {
         return false;
     }
 
-    m_chunkCache.put(pos, it->second.get());
+    reader(*it->second);
     return true;
 }
 
-bool Dimension::hasChunk(const ChunkPos &pos) const { return m_chunks.find(pos) != m_chunks.end(); }
+std::unique_lock<std::shared_mutex> Dimension::lockLightWrites() const
+{
+    return std::unique_lock<std::shared_mutex>(m_lightMutex);
+}
 
 const std::unordered_map<ChunkPos, std::unique_ptr<Chunk>, ChunkPosHash> &
 Dimension::getChunks() const
@@ -82,78 +151,85 @@ Dimension::getChunks() const
 
 void Dimension::markChunkDirty(const BlockPos &pos)
 {
-    std::lock_guard<std::mutex> lock(m_dirtyMutex);
-
     int cx = Mth::floorDiv(pos.x, Chunk::SIZE_X);
     int cy = Mth::floorDiv(pos.y, Chunk::SIZE_Y);
     int cz = Mth::floorDiv(pos.z, Chunk::SIZE_Z);
 
-    ChunkPos chunkPos{cx, cy, cz};
-    if (m_dirtyChunksSet.insert(chunkPos).second)
-    {
-        m_dirtyChunks.push_back(chunkPos);
-    }
+    markChunkDirty(ChunkPos(cx, cy, cz));
+}
+
+void Dimension::markChunkDirty(const ChunkPos &pos)
+{
+    queueDirtyChunk(&m_dirtyChunks, pos, Chunk::MESH_DIRTY);
 }
 
 void Dimension::markChunkDirtyUrgent(const ChunkPos &pos)
 {
-    std::lock_guard<std::mutex> lock(m_dirtyMutex);
-    if (m_urgentDirtyChunksSet.insert(pos).second)
-    {
-        m_urgentDirtyChunks.push_front(pos);
-    }
+    queueDirtyChunk(&m_urgentDirtyChunks, pos, Chunk::MESH_DIRTY_URGENT);
 }
 
-bool Dimension::pollDirtyChunk(ChunkPos *outPos)
+bool Dimension::pollDirtyChunk(const ChunkPriority &priority, ChunkPos *outPos)
 {
-    std::lock_guard<std::mutex> lock(m_dirtyMutex);
-    if (m_dirtyChunks.empty())
-    {
-        return false;
-    }
+    return pollDirtyQueue(&m_dirtyChunks, priority, Chunk::MESH_DIRTY, outPos);
+}
 
-    *outPos = m_dirtyChunks.front();
-    m_dirtyChunks.pop_front();
-    m_dirtyChunksSet.erase(*outPos);
-    return true;
+bool Dimension::pollUrgentDirtyChunk(const ChunkPriority &priority, ChunkPos *outPos)
+{
+    return pollDirtyQueue(&m_urgentDirtyChunks, priority, Chunk::MESH_DIRTY_URGENT, outPos);
 }
 
-bool Dimension::pollUrgentDirtyChunk(ChunkPos *outPos)
+void Dimension::clearDirtyChunks()
 {
-    std::lock_guard<std::mutex> lock(m_dirtyMutex);
-    if (m_urgentDirtyChunks.empty())
+    std::vector<ChunkPos> pending;
+    m_dirtyChunks.drain(&pending);
+    m_urgentDirtyChunks.drain(&pending);
+
+    for (const ChunkPos &pos : pending)
     {
-        return false;
+        if (Chunk *chunk = getChunk(pos))
+        {
+            chunk->clearMeshDirty(Chunk::MESH_DIRTY | Chunk::MESH_DIRTY_URGENT);
+        }
     }
-
-    *outPos = m_urgentDirtyChunks.front();
-    m_urgentDirtyChunks.pop_front();
-    m_urgentDirtyChunksSet.erase(*outPos);
-    return true;
 }
 
-void Dimension::clearDirtyChunks()
+std::vector<ChunkPos> Dimension::getDirtyChunks() const
 {
-    std::lock_guard<std::mutex> lock(m_dirtyMutex);
-
-    m_dirtyChunks.clear();
-    m_dirtyChunksSet.clear();
-    m_urgentDirtyChunks.clear();
-    m_urgentDirtyChunksSet.clear();
+    std::vector<ChunkPos> pending;
+    m_dirtyChunks.getPending(&pending);
+    return pending;
 }
 
-const std::deque<ChunkPos> &Dimension::getDirtyChunks() const { return m_dirtyChunks; }
+size_t Dimension::getQueuedDirtyChunkCount() const { return m_dirtyChunks.size(); }
+
+size_t Dimension::getUrgentDirtyChunkCount() const { return m_urgentDirtyChunks.size(); }
 
-size_t Dimension::getQueuedDirtyChunkCount() const
+void Dimension::queueDirtyChunk(DirtyChunkQueue *queue, const ChunkPos &pos, uint8_t flag)
 {
-    std::lock_guard<std::mutex> lock(m_dirtyMutex);
-    return m_dirtyChunks.size();
+    Chunk *chunk = getChunk(pos);
+    if (chunk && chunk->markMeshDirty(flag))
+    {
+        queue->push(pos);
+    }
 }
 
-size_t Dimension::getUrgentDirtyChunkCount() const
+bool Dimension::pollDirtyQueue(DirtyChunkQueue *queue, const ChunkPriority &priority, uint8_t flag,
+                               ChunkPos *outPos)
 {
-    std::lock_guard<std::mutex> lock(m_dirtyMutex);
-    return m_urgentDirtyChunks.size();
+    ChunkPos pos;
+    while (queue->poll(priority, &pos))
+    {
+        Chunk *chunk = getChunk(pos);
+        if (!chunk)
+        {
+            continue;
+        }
+
+        chunk->clearMeshDirty(flag);
+        *outPos = pos;
+        return true;
+    }
+    return false;
 }
 
 uint32_t Dimension::getBlockId(const BlockPos &pos) const
@@ -196,19 +272,17 @@ int Dimension::getSurfaceHeight(int levelX, int levelZ) const
         localZ += Chunk::SIZE_Z;
     }
 
-    ChunkPos pos{chunkX, 0, chunkZ};
-
-    auto it = m_chunks.find(pos);
-    if (it == m_chunks.end())
+    const Chunk *chunkPtr = getChunk(ChunkPos{chunkX, 0, chunkZ});
+    if (!chunkPtr)
     {
         return 0;
     }
 
-    const Chunk &chunk = *it->second;
+    const Chunk &chunk = *chunkPtr;
 
     for (int y = Chunk::SIZE_Y - 1; y >= 0; y--)
     {
-        if (Block::byId(chunk.getBlockId(localX, y, localZ))->isSolid())
+        if (BlockProperties::isSolid(chunk.getBlockId(localX, y, localZ)))
         {
             return y;
         }
@@ -227,21 +301,18 @@ bool Dimension::intersectsBlock(const AABB &aabb) const
     int maxY = (int) floor(aabb.getMax().y - 1e-6);
     int maxZ = (int) floor(aabb.getMax().z - 1e-6);
 
+    ConstRegionView region(*this, minX, minZ, maxX, maxZ);
     for (int z = minZ; z <= maxZ; z++)
     {
-        for (int y = minY; y <= maxY; y++)
+        for (int x = minX; x <= maxX; x++)
         {
-            for (int x = minX; x <= maxX; x++)
-            {
-                int cx = Mth::floorDiv(x, Chunk::SIZE_X);
-                int cy = Mth::floorDiv(y, Chunk::SIZE_Y);
-                int cz = Mth::floorDiv(z, Chunk::SIZE_Z);
-
-                int lx = Mth::floorMod(x, Chunk::SIZE_X);
-                int lz = Mth::floorMod(z, Chunk::SIZE_Z);
+            const Chunk *chunk = region.getChunk(x, z);
+            int lx             = x & ConstRegionView::LOCAL_MASK;
+            int lz             = z & ConstRegionView::LOCAL_MASK;
 
-                const Chunk *chunk = getChunk({cx, cy, cz});
-                if (!chunk)
+            for (int y = minY; y <= maxY; y++)
+            {
+                if (!chunk || y < 0 || y >= Chunk::SIZE_Y)
                 {
                     if (m_emptyChunksSolid)
                     {
@@ -250,8 +321,7 @@ bool Dimension::intersectsBlock(const AABB &aabb) const
                     continue;
                 }
 
-                Block *block = Block::byId(chunk->getBlockId(lx, y, lz));
-                if (!block->isSolid())
+                if (!BlockProperties::isSolid(chunk->getBlockId(lx, y, lz)))
                 {
                     continue;
                 }
@@ -288,7 +358,16 @@ bool Dimension::pollLightUpdate(BlockPos *outPos)
 
 size_t Dimension::getQueuedLightUpdateCount() const { return m_lightUpdates.size(); }
 
-void Dimension::setRenderDistance(int distance) { m_renderDistance = distance; }
+void Dimension::setRenderDistance(int distance)
+{
+    if (distance == m_renderDistance)
+    {
+        return;
+    }
+
+    m_renderDistance = distance;
+    m_chunkCache.rebuild(m_renderDistance + CACHE_MARGIN, m_chunks);
+}
 
 int Dimension::getRenderDistance() const { return m_renderDistance; }
 
@@ -1,15 +1,19 @@
 #pragma once
 
 #include <deque>
+#include <functional>
 #include <memory>
 #include <mutex>
+#include <shared_mutex>
 #include <unordered_map>
-#include <unordered_set>
+#include <vector>
 
 #include "DimensionTime.h"
 #include "block/BlockPos.h"
 #include "chunk/Chunk.h"
 #include "chunk/ChunkPos.h"
+#include "chunk/ChunkPriority.h"
+#include "chunk/DirtyChunkQueue.h"
 #include "chunk/storage/ChunkCache.h"
 #include "environment/Fog.h"
 
@@ -22,15 +26,20 @@ public:
     const Chunk *getChunk(const ChunkPos &pos) const;
     Chunk &createChunk(const ChunkPos &pos);
     bool adoptChunk(const ChunkPos &pos, std::unique_ptr<Chunk> chunk);
+    std::unique_ptr<Chunk> removeChunk(const ChunkPos &pos);
     bool hasChunk(const ChunkPos &pos) const;
+    bool readChunk(const ChunkPos &pos, const std::function<void(const Chunk &)> &reader) const;
+    // Held by light writers; readChunk takes it shared so workers never see a half-written update.
+    std::unique_lock<std::shared_mutex> lockLightWrites() const;
     const std::unordered_map<ChunkPos, std::unique_ptr<Chunk>, ChunkPosHash> &getChunks() const;
 
     void markChunkDirty(const BlockPos &pos);
+    void markChunkDirty(const ChunkPos &pos);
     void markChunkDirtyUrgent(const ChunkPos &pos);
-    bool pollDirtyChunk(ChunkPos *outPos);
-    bool pollUrgentDirtyChunk(ChunkPos *outPos);
+    bool pollDirtyChunk(const ChunkPriority &priority, ChunkPos *outPos);
+    bool pollUrgentDirtyChunk(const ChunkPriority &priority, ChunkPos *outPos);
     void clearDirtyChunks();
-    const std::deque<ChunkPos> &getDirtyChunks() const;
+    std::vector<ChunkPos> getDirtyChunks() const;
     size_t getQueuedDirtyChunkCount() const;
     size_t getUrgentDirtyChunkCount() const;
 
@@ -63,13 +72,18 @@ public:
     int getDarkPeakTick() const;
 
 private:
+    static constexpr int CACHE_MARGIN = 2;
+
+    void queueDirtyChunk(DirtyChunkQueue *queue, const ChunkPos &pos, uint8_t flag);
+    bool pollDirtyQueue(DirtyChunkQueue *queue, const ChunkPriority &priority, uint8_t flag,
+                        ChunkPos *outPos);
+
     std::unordered_map<ChunkPos, std::unique_ptr<Chunk>, ChunkPosHash> m_chunks;
+    mutable std::shared_mutex m_chunksMutex;
+    mutable std::shared_mutex m_lightMutex;
     mutable ChunkCache m_chunkCache;
-    std::deque<ChunkPos> m_dirtyChunks;
-    std::deque<ChunkPos> m_urgentDirtyChunks;
-    std::unordered_set<ChunkPos, ChunkPosHash> m_dirtyChunksSet;
-    std::unordered_set<ChunkPos, ChunkPosHash> m_urgentDirtyChunksSet;
-    mutable std::mutex m_dirtyMutex;
+    DirtyChunkQueue m_dirtyChunks;
+    DirtyChunkQueue m_urgentDirtyChunks;
     std::deque<BlockPos> m_lightUpdates;
     bool m_emptyChunksSolid;
     int m_renderDistance;
@@ -0,0 +1,88 @@
+#include "FrameBudget.h"
+
+#include <algorithm>
+#include <cmath>
+
+static constexpr double COST_SMOOTHING = 0.2;
+static constexpr double INITIAL_COST   = 0.25;
+static constexpr double MIN_COST       = 0.0001;
+
+static double millisSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+            .count();
+}
+
+FrameBudget::FrameBudget() : m_budget(DEFAULT_BUDGET_MS), m_remaining(DEFAULT_BUDGET_MS)
+{
+    m_phases[(size_t) Phase::CHUNK_SAVES]   = {1, 1, 64, INITIAL_COST, 0.0, 0, 0, false, {}};
+    m_phases[(size_t) Phase::CHUNK_INTAKE]  = {3, 1, 128, INITIAL_COST, 0.0, 0, 0, false, {}};
+    m_phases[(size_t) Phase::URGENT_MESHES] = {4, 1, 32, INITIAL_COST, 0.0, 0, 0, false, {}};
+    m_phases[(size_t) Phase::LIGHTING]      = {2, 8, 4096, INITIAL_COST, 0.0, 0, 0, false, {}};
+    m_phases[(size_t) Phase::MESHES]        = {2, 1, 256, INITIAL_COST, 0.0, 0, 0, false, {}};
+    m_phases[(size_t) Phase::SKY_LIGHT]     = {1, 4, 1024, INITIAL_COST, 0.0, 0, 0, false, {}};
+}
+
+void FrameBudget::setBudgetMillis(double milliseconds)
+{
+    m_budget = std::clamp(milliseconds, MIN_BUDGET_MS, MAX_BUDGET_MS);
+}
+
+double FrameBudget::getBudgetMillis() const { return m_budget; }
+
+void FrameBudget::beginFrame()
+{
+    m_remaining = m_budget;
+    for (PhaseState &state : m_phases)
+    {
+        state.done = false;
+    }
+}
+
+int FrameBudget::beginPhase(Phase phase, size_t backlog)
+{
+    PhaseState &state = m_phases[(size_t) phase];
+    state.backlog     = backlog;
+    state.start       = std::chrono::steady_clock::now();
+
+    if (backlog == 0)
+    {
+        state.allowance = 0;
+        return 0;
+    }
+
+    int weights = 0;
+    for (const PhaseState &other : m_phases)
+    {
+        if (&other == &state || (!other.done && other.backlog > 0))
+        {
+            weights += other.weight;
+        }
+    }
+
+    double share = std::max(0.0, m_remaining) * (double) state.weight / (double) weights;
+    double items = std::floor(share / state.cost);
+    int allowance = (int) std::clamp(items, (double) state.minItems, (double) state.maxItems);
+    state.allowance = (int) std::min((size_t) allowance, backlog);
+    return state.allowance;
+}
+
+void FrameBudget::endPhase(Phase phase, int processed)
+{
+    PhaseState &state = m_phases[(size_t) phase];
+    state.spent       = millisSince(state.start);
+    state.done        = true;
+
+    m_remaining -= state.spent;
+    if (processed > 0)
+    {
+        double cost = state.spent / (double) processed;
+        state.cost  = std::max(state.cost + (cost - state.cost) * COST_SMOOTHING, MIN_COST);
+    }
+}
+
+double FrameBudget::getCostMillis(Phase phase) const { return m_phases[(size_t) phase].cost; }
+
+double FrameBudget::getSpentMillis(Phase phase) const { return m_phases[(size_t) phase].spent; }
+
+int FrameBudget::getAllowance(Phase phase) const { return m_phases[(size_t) phase].allowance; }
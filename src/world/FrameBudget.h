@@ -0,0 +1,58 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+class FrameBudget
+{
+public:
+    enum class Phase : uint8_t
+    {
+        CHUNK_SAVES   = 0,
+        CHUNK_INTAKE  = 1,
+        URGENT_MESHES = 2,
+        LIGHTING      = 3,
+        MESHES        = 4,
+        SKY_LIGHT     = 5,
+        COUNT         = 6,
+    };
+
+    static constexpr double DEFAULT_BUDGET_MS = 4.0;
+    static constexpr double MIN_BUDGET_MS     = 1.0;
+    static constexpr double MAX_BUDGET_MS     = 16.0;
+    static constexpr double BUDGET_STEP_MS    = 1.0;
+
+    FrameBudget();
+
+    void setBudgetMillis(double milliseconds);
+    double getBudgetMillis() const;
+
+    void beginFrame();
+    int beginPhase(Phase phase, size_t backlog);
+    void endPhase(Phase phase, int processed);
+
+    double getCostMillis(Phase phase) const;
+    double getSpentMillis(Phase phase) const;
+    int getAllowance(Phase phase) const;
+
+private:
+    static constexpr size_t PHASE_COUNT = (size_t) Phase::COUNT;
+
+    struct PhaseState
+    {
+        int weight;
+        int minItems;
+        int maxItems;
+        double cost;
+        double spent;
+        size_t backlog;
+        int allowance;
+        bool done;
+        std::chrono::steady_clock::time_point start;
+    };
+
+    double m_budget;
+    double m_remaining;
+    PhaseState m_phases[PHASE_COUNT];
+};
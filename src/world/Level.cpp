@@ -5,6 +5,7 @@
 #include <cmath>
 #include <cstdint>
 
+#include "../core/Logger.h"
 #include "../core/Minecraft.h"
 #include "../entity/Entity.h"
 #include "../entity/TestEntity.h"
@@ -12,6 +13,11 @@
 #include "../utils/math/Mth.h"
 #include "LevelRenderer.h"
 #include "block/Block.h"
+#include "block/BlockRegistry.h"
+#include "block/Blocks.h"
+#include "chunk/ChunkPriority.h"
+#include "chunk/RegionView.h"
+#include "chunk/storage/ChunkStorage.h"
 #include "lighting/LightEngine.h"
 #include "lighting/dynamic/DynamicLightManager.h"
 #include "particle/ParticleEngine.h"
@@ -105,11 +111,26 @@ static Direction *decodeDirection(uint8_t face)
     return nullptr;
 }
 
-Level::Level()
-    : m_dimension(), m_entities(), m_scheduledBlockTicks(), m_worldBorderEnabled(false),
-      m_worldBorderChunks(32)
+static ChunkPos getViewerChunkPos()
+{
+    Vec3 position = Minecraft::getInstance()->getLocalPlayer()->getPosition();
+    return ChunkPos(Mth::floorDiv((int) position.x, Chunk::SIZE_X), 0,
+                    Mth::floorDiv((int) position.z, Chunk::SIZE_Z));
+}
+
+static ChunkPriority getViewerPriority(int renderDistance)
+{
+    Entity *viewer = Minecraft::getInstance()->getLocalPlayer();
+    return ChunkPriority(viewer->getPosition(), viewer->getVelocity(), viewer->getFront(),
+                         renderDistance);
+}
+
+Level::Level(uint32_t seed)
+    : m_dimension(), m_lastEvictionCenter{INT32_MAX, INT32_MAX, INT32_MAX}, m_entities(),
+      m_scheduledBlockTicks(), m_seed(seed), m_worldBorderEnabled(false), m_worldBorderChunks(32)
 {
     m_dimension.setEmptyChunksSolid(false);
+    m_chunkStorage        = ChunkStorage::createTemporary();
     m_particleEngine      = std::make_unique<ParticleEngine>();
     m_renderObjectManager = std::make_unique<LevelRenderObjectManager>();
     m_dynamicLightManager = std::make_unique<DynamicLightManager>();
@@ -119,6 +140,8 @@ Level::~Level() {}
 
 void Level::update(float partialTicks)
 {
+    m_frameBudget.beginFrame();
+
     updateChunks();
     updateLighting();
     updateMeshes();
@@ -134,100 +157,199 @@ void Level::tick()
     m_dimension.advanceTime();
 }
 
+void Level::setSeed(uint32_t seed)
+{
+    if (m_seed == seed)
+    {
+        return;
+    }
+    m_seed = seed;
+
+    ChunkManager *chunkManager = Minecraft::getInstance()->getChunkManager();
+    if (chunkManager && chunkManager->getLevel() == this)
+    {
+        chunkManager->setLevel(this);
+    }
+}
+
+uint32_t Level::getSeed() const { return m_seed; }
+
 void Level::updateChunks()
 {
+    evictChunks();
+
     if (ChunkManager *chunkManager = Minecraft::getInstance()->getChunkManager())
     {
+        int intakeBudget = m_frameBudget.beginPhase(FrameBudget::Phase::CHUNK_INTAKE,
+                                                    chunkManager->getFinishedCount());
+
         std::deque<std::pair<ChunkPos, std::unique_ptr<Chunk>>> ready;
-        chunkManager->drainFinished(&ready, 2);
+        chunkManager->drainFinished(&ready, intakeBudget);
+
+        for (auto &[pos, chunkPtr] : ready)
+        {
+            bool adopted = commitChunk(pos, std::move(chunkPtr));
+            chunkManager->notifyCommitted(pos, adopted);
+        }
+
+        m_frameBudget.endPhase(FrameBudget::Phase::CHUNK_INTAKE, (int) ready.size());
+    }
+
+    int urgentBudget = m_frameBudget.beginPhase(FrameBudget::Phase::URGENT_MESHES,
+                                                m_dimension.getUrgentDirtyChunkCount());
+
+    int processed = 0;
+    if (LevelRenderer *levelRenderer = Minecraft::getInstance()->getLevelRenderer())
+    {
+        ChunkPriority priority = getViewerPriority(getRenderDistance());
+        processed              = levelRenderer->scheduleRebuilds(priority, true, urgentBudget);
+    }
+
+    m_frameBudget.endPhase(FrameBudget::Phase::URGENT_MESHES, processed);
+}
+
+bool Level::commitChunk(const ChunkPos &pos, std::unique_ptr<Chunk> chunk)
+{
+    return m_dimension.adoptChunk(pos, std::move(chunk));
+}
+
+void Level::evictChunks()
+{
+    releaseRetiredChunks();
 
-        const int chunkIntakeBudget = 2;
-        int intook                  = 0;
+    ChunkPos center = getViewerChunkPos();
+    if (center == m_lastEvictionCenter)
+    {
+        return;
+    }
 
-        while (!ready.empty() && intook < chunkIntakeBudget)
+    int evictDistance = getRenderDistance() + 2;
+    int maxD2         = evictDistance * evictDistance;
+
+    std::vector<ChunkPos> evicted;
+    for (const auto &[pos, _] : m_dimension.getChunks())
+    {
+        int dx = pos.x - center.x;
+        int dz = pos.z - center.z;
+        if (dx * dx + dz * dz > maxD2)
         {
-            intook++;
-            auto [pos, chunkPtr] = std::move(ready.front());
-            ready.pop_front();
+            evicted.push_back(pos);
+        }
+    }
 
-            if (!m_dimension.adoptChunk(pos, std::move(chunkPtr)))
-            {
-                continue;
-            }
+    if (evicted.empty())
+    {
+        m_lastEvictionCenter = center;
+        return;
+    }
 
-            BlockPos blockPos(pos.x * Chunk::SIZE_X, pos.y * Chunk::SIZE_Y, pos.z * Chunk::SIZE_Z);
-            m_dimension.markChunkDirty(blockPos);
-            if (hasChunk(ChunkPos(pos.x - 1, pos.y, pos.z)))
-            {
-                m_dimension.markChunkDirty(
-                        BlockPos(blockPos.x - Chunk::SIZE_X, blockPos.y, blockPos.z));
-            }
-            if (hasChunk(ChunkPos(pos.x + 1, pos.y, pos.z)))
-            {
-                m_dimension.markChunkDirty(
-                        BlockPos(blockPos.x + Chunk::SIZE_X, blockPos.y, blockPos.z));
-            }
-            if (hasChunk(ChunkPos(pos.x, pos.y, pos.z - 1)))
-            {
-                m_dimension.markChunkDirty(
-                        BlockPos(blockPos.x, blockPos.y, blockPos.z - Chunk::SIZE_Z));
-            }
-            if (hasChunk(ChunkPos(pos.x, pos.y, pos.z + 1)))
-            {
-                m_dimension.markChunkDirty(
-                        BlockPos(blockPos.x, blockPos.y, blockPos.z + Chunk::SIZE_Z));
-            }
+    bool storeUnmodified = m_chunkStorage && m_chunkStorage->shouldStoreUnmodified();
+    size_t pendingSaves  = 0;
+    for (const ChunkPos &pos : evicted)
+    {
+        Chunk *chunk = m_dimension.getChunk(pos);
+        if (!chunk->isUnmodified() || (storeUnmodified && !m_chunkStorage->has(pos)))
+        {
+            pendingSaves++;
         }
     }
 
-    const int urgentBudget = 2;
+    int saveBudget = m_frameBudget.beginPhase(FrameBudget::Phase::CHUNK_SAVES, pendingSaves);
 
     LevelRenderer *levelRenderer = Minecraft::getInstance()->getLevelRenderer();
-    for (int i = 0; i < urgentBudget; i++)
+    uint64_t ticket              = levelRenderer ? levelRenderer->getMesherRetireTicket() : 0;
+
+    int saved     = 0;
+    bool deferred = false;
+    for (const ChunkPos &pos : evicted)
     {
-        ChunkPos pos;
-        if (!m_dimension.pollUrgentDirtyChunk(&pos))
+        Chunk *chunk = m_dimension.getChunk(pos);
+        if (!chunk->isUnmodified() || (storeUnmodified && !m_chunkStorage->has(pos)))
         {
-            break;
+            if (saved >= saveBudget)
+            {
+                deferred = true;
+                continue;
+            }
+
+            saved++;
+            bool stored = m_chunkStorage && m_chunkStorage->save(*chunk);
+            if (!stored && !chunk->isUnmodified())
+            {
+                Logger::logError("Failed to save chunk (%d, %d, %d), keeping it loaded", pos.x,
+                                 pos.y, pos.z);
+                continue;
+            }
         }
 
         if (levelRenderer)
         {
-            levelRenderer->rebuildChunkUrgent(pos);
+            levelRenderer->dropChunk(pos);
         }
+
+        m_retiredChunks.emplace_back(ticket, m_dimension.removeChunk(pos));
+    }
+
+    m_frameBudget.endPhase(FrameBudget::Phase::CHUNK_SAVES, saved);
+
+    if (!deferred)
+    {
+        m_lastEvictionCenter = center;
     }
 }
 
+void Level::releaseRetiredChunks()
+{
+    if (m_retiredChunks.empty())
+    {
+        return;
+    }
+
+    LevelRenderer *levelRenderer = Minecraft::getInstance()->getLevelRenderer();
+    m_retiredChunks.erase(std::remove_if(m_retiredChunks.begin(), m_retiredChunks.end(),
+                                         [levelRenderer](const auto &retired) {
+                                             return !levelRenderer ||
+                                                    levelRenderer->isMesherTicketRetired(
+                                                            retired.first);
+                                         }),
+                          m_retiredChunks.end());
+}
+
 void Level::updateLighting()
 {
-    const int lightBudget = 32;
+    int lightBudget = m_frameBudget.beginPhase(FrameBudget::Phase::LIGHTING,
+                                               m_dimension.getQueuedLightUpdateCount());
 
-    for (int processed = 0; processed < lightBudget; processed++)
+    m_lightBatch.clear();
+    BlockPos pos;
+    while ((int) m_lightBatch.size() < lightBudget && m_dimension.pollLightUpdate(&pos))
     {
-        BlockPos pos;
-        if (!m_dimension.pollLightUpdate(&pos))
+        m_lightBatch.push_back(pos);
+    }
+
+    if (!m_lightBatch.empty())
+    {
+        m_lightDirtyChunks.clear();
+        LightEngine::updateFrom(this, m_lightBatch, &m_lightDirtyChunks);
+        for (const ChunkPos &chunkPos : m_lightDirtyChunks)
         {
-            break;
+            markChunkDirtyUrgent(chunkPos);
         }
-
-        LightEngine::updateFrom(this, pos);
     }
+
+    m_frameBudget.endPhase(FrameBudget::Phase::LIGHTING, (int) m_lightBatch.size());
 }
 
 void Level::updateMeshes()
 {
-    const int meshBudget = 16;
+    int meshBudget = m_frameBudget.beginPhase(FrameBudget::Phase::MESHES,
+                                              m_dimension.getQueuedDirtyChunkCount());
 
-    for (int i = 0; i < meshBudget; i++)
-    {
-        ChunkPos pos;
-        if (!m_dimension.pollDirtyChunk(&pos))
-        {
-            break;
-        }
+    LevelRenderer *levelRenderer = Minecraft::getInstance()->getLevelRenderer();
+    ChunkPriority priority       = getViewerPriority(getRenderDistance());
+    int processed                = levelRenderer->scheduleRebuilds(priority, false, meshBudget);
 
-        Minecraft::getInstance()->getLevelRenderer()->rebuildChunk(pos);
-    }
+    m_frameBudget.endPhase(FrameBudget::Phase::MESHES, processed);
 }
 
 void Level::updateParticles()
@@ -240,6 +362,8 @@ void Level::updateParticles()
 
 Dimension *Level::getDimension() { return &m_dimension; }
 
+FrameBudget &Level::getFrameBudget() { return m_frameBudget; }
+
 const Dimension *Level::getDimension() const { return &m_dimension; }
 
 Chunk *Level::getChunk(const ChunkPos &pos) { return m_dimension.getChunk(pos); }
@@ -250,6 +374,14 @@ Chunk &Level::createChunk(const ChunkPos &pos) { return m_dimension.createChunk(
 
 bool Level::hasChunk(const ChunkPos &pos) const { return m_dimension.hasChunk(pos); }
 
+bool Level::readChunk(const ChunkPos &pos,
+                      const std::function<void(const Chunk &)> &reader) const
+{
+    return m_dimension.readChunk(pos, reader);
+}
+
+ChunkStorage *Level::getChunkStorage() const { return m_chunkStorage.get(); }
+
 const std::unordered_map<ChunkPos, std::unique_ptr<Chunk>, ChunkPosHash> &Level::getChunks() const
 {
     return m_dimension.getChunks();
@@ -261,7 +393,7 @@ void Level::markChunkDirtyUrgent(const ChunkPos &pos) { m_dimension.markChunkDir
 
 void Level::clearDirtyChunks() { m_dimension.clearDirtyChunks(); }
 
-const std::deque<ChunkPos> &Level::getDirtyChunks() const { return m_dimension.getDirtyChunks(); }
+std::vector<ChunkPos> Level::getDirtyChunks() const { return m_dimension.getDirtyChunks(); }
 
 size_t Level::getQueuedDirtyChunkCount() const { return m_dimension.getQueuedDirtyChunkCount(); }
 
@@ -591,7 +723,14 @@ void Level::setBlock(const BlockPos &pos, Block *block) { setBlock(pos, block, n
 
 void Level::setBlock(const BlockPos &pos, Block *block, Direction *placedAgainst)
 {
-    if (pos.y == 0 && block == Block::byName("air"))
+    setBlockId(pos, BlockRegistry::get()->idOf(block), placedAgainst);
+}
+
+void Level::setBlockId(const BlockPos &pos, uint32_t id) { setBlockId(pos, id, nullptr); }
+
+void Level::setBlockId(const BlockPos &pos, uint32_t id, Direction *placedAgainst)
+{
+    if (pos.y == 0 && id == Blocks::AIR.getId())
     {
         return;
     }
@@ -611,18 +750,21 @@ void Level::setBlock(const BlockPos &pos, Block *block, Direction *placedAgainst
         return;
     }
 
-    Block *oldBlock = Block::byId(chunk->getBlockId(lx, ly, lz));
-    if (oldBlock && oldBlock != block)
+    uint32_t oldId  = chunk->getBlockId(lx, ly, lz);
+    Block *oldBlock = Block::byId(oldId);
+    if (oldBlock && oldId != id)
     {
         oldBlock->onBreak(this, pos);
     }
 
-    chunk->setBlock(lx, ly, lz, block);
+    chunk->setBlockId(lx, ly, lz, id);
+    chunk->setUnmodified(false);
 
     Direction *supportFace = oppositeDirection(placedAgainst);
     chunk->setBlockAttachmentFace(lx, ly, lz, encodeDirection(supportFace));
 
-    if (block && oldBlock != block)
+    Block *block = Block::byId(id);
+    if (block && oldId != id)
     {
         block->onPlace(this, pos);
     }
@@ -834,6 +976,12 @@ HitResult *Level::clip(const Vec3 &origin, const Vec3 &direction, float maxDista
         tMaxZ = 0.0f;
     }
 
+    Vec3 end = origin.add(normalizedDirection.scale(maxDistance));
+    RegionView region(*this, (int) floor(std::min(origin.x, end.x)) - 1,
+                      (int) floor(std::min(origin.z, end.z)) - 1,
+                      (int) floor(std::max(origin.x, end.x)) + 1,
+                      (int) floor(std::max(origin.z, end.z)) + 1);
+
     float bestBlockT = std::numeric_limits<float>::max();
     BlockPos bestBlockPos;
     Direction *bestFace = nullptr;
@@ -884,22 +1032,14 @@ HitResult *Level::clip(const Vec3 &origin, const Vec3 &direction, float maxDista
             break;
         }
 
-        ChunkPos chunkPos(Mth::floorDiv(pos.x, Chunk::SIZE_X), Mth::floorDiv(pos.y, Chunk::SIZE_Y),
-                          Mth::floorDiv(pos.z, Chunk::SIZE_Z));
-
-        int lx = Mth::floorMod(pos.x, Chunk::SIZE_X);
-        int lz = Mth::floorMod(pos.z, Chunk::SIZE_Z);
-
-        Chunk *chunk = getChunk(chunkPos);
+        Chunk *chunk = region.getChunk(pos.x, pos.y, pos.z);
         if (!chunk)
         {
             continue;
         }
 
-        if (pos.y < 0 || pos.y >= Chunk::SIZE_Y)
-        {
-            continue;
-        }
+        int lx = pos.x & RegionView::LOCAL_MASK;
+        int lz = pos.z & RegionView::LOCAL_MASK;
 
         Block *block = Block::byId((int) chunk->getBlockId(lx, pos.y, lz));
         if (!block)
@@ -1,15 +1,18 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <queue>
 #include <vector>
 
 #include "../utils/HitResult.h"
 #include "Dimension.h"
+#include "FrameBudget.h"
 #include "lighting/dynamic/DynamicLight.h"
 #include "render/LevelRenderObject.h"
 
+class ChunkStorage;
 class Entity;
 class ParticleEngine;
 class LevelRenderObjectManager;
@@ -20,29 +23,36 @@ enum class ParticleType : uint16_t;
 class Level
 {
 public:
-    Level();
+    explicit Level(uint32_t seed);
     ~Level();
 
     void update(float partialTicks);
     void tick();
 
+    void setSeed(uint32_t seed);
+    uint32_t getSeed() const;
+
     void updateChunks();
+    void evictChunks();
     void updateLighting();
     void updateMeshes();
     void updateParticles();
 
     Dimension *getDimension();
+    FrameBudget &getFrameBudget();
     const Dimension *getDimension() const;
 
     Chunk *getChunk(const ChunkPos &pos);
     const Chunk *getChunk(const ChunkPos &pos) const;
     Chunk &createChunk(const ChunkPos &pos);
     bool hasChunk(const ChunkPos &pos) const;
+    bool readChunk(const ChunkPos &pos, const std::function<void(const Chunk &)> &reader) const;
+    ChunkStorage *getChunkStorage() const;
     const std::unordered_map<ChunkPos, std::unique_ptr<Chunk>, ChunkPosHash> &getChunks() const;
     void markChunkDirty(const BlockPos &pos);
     void markChunkDirtyUrgent(const ChunkPos &pos);
     void clearDirtyChunks();
-    const std::deque<ChunkPos> &getDirtyChunks() const;
+    std::vector<ChunkPos> getDirtyChunks() const;
     size_t getQueuedDirtyChunkCount() const;
     size_t getUrgentDirtyChunkCount() const;
 
@@ -86,6 +96,8 @@ public:
     uint32_t getBlockId(const BlockPos &pos) const;
     void setBlock(const BlockPos &pos, Block *block);
     void setBlock(const BlockPos &pos, Block *block, Direction *placedAgainst);
+    void setBlockId(const BlockPos &pos, uint32_t id);
+    void setBlockId(const BlockPos &pos, uint32_t id, Direction *placedAgainst);
     void scheduleBlockForTick(const BlockPos &pos, uint32_t delayTicks, int priority);
     void setWorldBorderEnabled(bool enabled);
     bool isWorldBorderEnabled() const;
@@ -142,13 +154,22 @@ private:
     };
 
     void processScheduledBlockTicks(uint64_t nowTick);
+    bool commitChunk(const ChunkPos &pos, std::unique_ptr<Chunk> chunk);
+    void releaseRetiredChunks();
 
     Dimension m_dimension;
+    FrameBudget m_frameBudget;
+    std::vector<BlockPos> m_lightBatch;
+    std::vector<ChunkPos> m_lightDirtyChunks;
+    std::unique_ptr<ChunkStorage> m_chunkStorage;
+    std::vector<std::pair<uint64_t, std::unique_ptr<Chunk>>> m_retiredChunks;
+    ChunkPos m_lastEvictionCenter;
     std::vector<std::unique_ptr<Entity>> m_entities;
     std::unique_ptr<ParticleEngine> m_particleEngine;
     std::unique_ptr<LevelRenderObjectManager> m_renderObjectManager;
     std::unique_ptr<DynamicLightManager> m_dynamicLightManager;
     std::priority_queue<ScheduledBlockTick> m_scheduledBlockTicks;
+    uint32_t m_seed;
     bool m_worldBorderEnabled;
     int m_worldBorderChunks;
 };
@@ -1,6 +1,9 @@
 #include "LevelRenderer.h"
 
-#include "../threading/ThreadStorage.h"
+#include <utility>
+#include <vector>
+
+#include "../threading/JobSystem.h"
 #include "lighting/Lighting.h"
 
 void LevelRenderer::rebuild()
@@ -13,14 +16,30 @@ void LevelRenderer::rebuild()
 
     const std::unordered_map<ChunkPos, std::unique_ptr<Chunk>, ChunkPosHash> &chunks =
             m_level->getChunks();
+
+    std::vector<std::pair<ChunkPos, const Chunk *>> order;
+    order.reserve(chunks.size());
     std::unordered_map<ChunkPos, std::unique_ptr<Chunk>, ChunkPosHash>::const_iterator chunkIt;
     for (chunkIt = chunks.begin(); chunkIt != chunks.end(); ++chunkIt)
     {
-        const ChunkPos &pos                    = chunkIt->first;
-        const std::unique_ptr<Chunk> &chunkPtr = chunkIt->second;
-        std::vector<ChunkMesher::MeshBuildResult> results;
-        ChunkMesher::buildMeshes(m_level, chunkPtr.get(), smoothLighting, grassSideOverlay,
-                                 &results);
+        order.emplace_back(chunkIt->first, chunkIt->second.get());
+    }
+
+    std::vector<std::vector<ChunkMesher::MeshBuildResult>> built(order.size());
+    JobSystem::get()->parallelFor(JobClass::MESHING, 0, order.size(), 1,
+                                  [&](size_t begin, size_t end) {
+                                      for (size_t i = begin; i < end; i++)
+                                      {
+                                          ChunkMesher::buildMeshes(m_level, order[i].second,
+                                                                   smoothLighting,
+                                                                   grassSideOverlay, &built[i]);
+                                      }
+                                  });
+
+    for (size_t i = 0; i < order.size(); i++)
+    {
+        const ChunkPos &pos                                = order[i].first;
+        std::vector<ChunkMesher::MeshBuildResult> &results = built[i];
 
         std::vector<std::unique_ptr<ChunkMesh>> meshes;
         meshes.reserve(results.size());
@@ -34,6 +53,7 @@ void LevelRenderer::rebuild()
                                std::move(result.shades), std::move(result.tints));
             meshes.push_back(std::move(renderMesh));
         }
+        results.clear();
 
         m_chunks.emplace(pos, std::move(meshes));
 
@@ -50,78 +70,89 @@ void LevelRenderer::rebuild()
     }
 }
 
-void LevelRenderer::rebuildChunk(const ChunkPos &pos)
+int LevelRenderer::scheduleRebuilds(const ChunkPriority &priority, bool urgent, int maxRebuilds)
 {
-    if (m_level->getChunks().find(pos) == m_level->getChunks().end())
-    {
-        return;
-    }
+    Dimension *dimension = m_level->getDimension();
 
+    int scheduled = 0;
+    while (scheduled < maxRebuilds && hasMesherCapacity())
     {
-        std::lock_guard<std::mutex> lock(m_rebuildQueueMutex);
-        m_requestedMeshGenerations[pos]++;
-
-        if (m_activeRebuilds.find(pos) != m_activeRebuilds.end())
+        ChunkPos pos;
+        bool polled = urgent ? dimension->pollUrgentDirtyChunk(priority, &pos)
+                             : dimension->pollDirtyChunk(priority, &pos);
+        if (!polled)
         {
-            if (m_deferredUrgentRebuilds.find(pos) == m_deferredUrgentRebuilds.end())
-            {
-                m_deferredRebuilds.insert(pos);
-            }
-            return;
+            break;
         }
 
-        if (m_rebuildQueued.insert(pos).second)
-        {
-            m_rebuildQueue.push(pos);
-        }
+        scheduleRebuild(pos, urgent);
+        scheduled++;
     }
-
-    scheduleMesher();
+    return scheduled;
 }
 
-void LevelRenderer::rebuildChunkUrgent(const ChunkPos &pos)
+void LevelRenderer::rebuildCommittedChunk(const ChunkPos &pos)
 {
-    if (m_level->getChunks().find(pos) == m_level->getChunks().end())
+    const Chunk *chunk = m_level->getChunk(pos);
+    if (!chunk || chunk->isMeshDirty())
     {
         return;
     }
 
+    if (!hasMesherCapacity())
     {
-        std::lock_guard<std::mutex> lock(m_rebuildQueueMutex);
-        m_requestedMeshGenerations[pos]++;
+        m_level->getDimension()->markChunkDirty(pos);
+        return;
+    }
 
-        if (m_activeRebuilds.find(pos) != m_activeRebuilds.end())
-        {
-            m_deferredRebuilds.erase(pos);
-            m_deferredUrgentRebuilds.insert(pos);
-            return;
-        }
+    scheduleRebuild(pos, false);
+}
 
-        if (m_urgentQueued.insert(pos).second)
-        {
-            m_urgentQueue.push(pos);
-        }
+void LevelRenderer::dropChunk(const ChunkPos &pos)
+{
+    m_chunks.erase(pos);
+    m_chunkFadeStates.erase(pos);
+    m_readyMeshes.erase(pos);
+
+    std::lock_guard<std::mutex> lock(m_rebuildQueueMutex);
+    m_requestedMeshGenerations[pos]++;
+    m_deferredRebuilds.erase(pos);
+    m_deferredUrgentRebuilds.erase(pos);
+
+    auto activeIt = m_activeRebuilds.find(pos);
+    if (activeIt != m_activeRebuilds.end())
+    {
+        activeIt->second.cancel();
     }
+}
 
-    scheduleMesher();
+uint64_t LevelRenderer::getMesherRetireTicket() const
+{
+    std::lock_guard<std::mutex> lock(m_rebuildQueueMutex);
+    return m_nextMesherTicket;
+}
+
+bool LevelRenderer::isMesherTicketRetired(uint64_t ticket) const
+{
+    std::lock_guard<std::mutex> lock(m_rebuildQueueMutex);
+    return m_activeMesherTickets.empty() || *m_activeMesherTickets.begin() >= ticket;
 }
 
 size_t LevelRenderer::getPendingMeshCount() const
 {
-    std::lock_guard<std::mutex> lock(m_meshQueueMutex);
     return m_pendingMeshes.size();
 }
 
-size_t LevelRenderer::getQueuedRebuildCount() const
+size_t LevelRenderer::getActiveRebuildCount() const
 {
     std::lock_guard<std::mutex> lock(m_rebuildQueueMutex);
-    return m_rebuildQueued.size();
+    return m_activeRebuilds.size();
 }
 
-size_t LevelRenderer::getUrgentRebuildCount() const
+size_t LevelRenderer::getDeferredRebuildCount() const
 {
     std::lock_guard<std::mutex> lock(m_rebuildQueueMutex);
-    return m_urgentQueued.size();
+    return m_deferredRebuilds.size() + m_deferredUrgentRebuilds.size();
 }
 
 void LevelRenderer::uploadPendingMeshes()
@@ -130,17 +161,9 @@ void LevelRenderer::uploadPendingMeshes()
     while (uploadsPerFrame-- > 0)
     {
         PendingMeshUpload pendingUpload;
-
+        if (!m_pendingMeshes.tryPop(&pendingUpload))
         {
-            std::lock_guard<std::mutex> lock(m_meshQueueMutex);
-
-            if (m_pendingMeshes.empty())
-            {
-                break;
-            }
-
-            pendingUpload = std::move(m_pendingMeshes.front());
-            m_pendingMeshes.pop_front();
+            break;
         }
 
         const ChunkPos &pos = pendingUpload.pos;
@@ -206,9 +229,9 @@ void LevelRenderer::presentReadyMeshes()
             for (const ChunkPos &offset : offsets)
             {
                 ChunkPos neighbor = pos + offset;
+                const Chunk *neighborChunk = m_level->getChunk(neighbor);
                 if (m_activeRebuilds.find(neighbor) != m_activeRebuilds.end() ||
-                    m_rebuildQueued.find(neighbor) != m_rebuildQueued.end() ||
-                    m_urgentQueued.find(neighbor) != m_urgentQueued.end() ||
+                    (neighborChunk && neighborChunk->isMeshDirty()) ||
                     m_deferredRebuilds.find(neighbor) != m_deferredRebuilds.end() ||
                     m_deferredUrgentRebuilds.find(neighbor) != m_deferredUrgentRebuilds.end())
                 {
@@ -246,123 +269,107 @@ void LevelRenderer::presentReadyMeshes()
     }
 }
 
-void LevelRenderer::scheduleMesher()
+bool LevelRenderer::hasMesherCapacity() const
 {
-    if (!m_mesherRunning || !m_mesherPool)
+    if (!m_mesherRunning)
     {
-        return;
+        return false;
     }
 
-    bool smoothLighting   = Lighting::isOn() && m_lightingMode == LightingMode::NEW;
-    bool grassSideOverlay = m_grassSideOverlayEnabled;
-    int maxMesherTasks    = (int) m_maxMesherTasks;
-    if (smoothLighting && maxMesherTasks > 2)
+    int maxMesherTasks = (int) m_maxMesherTasks;
+    if (Lighting::isOn() && m_lightingMode == LightingMode::NEW && maxMesherTasks > 2)
     {
         maxMesherTasks = 2;
     }
 
-    while (m_activeMesherTasks.load() < maxMesherTasks)
+    return m_activeMesherTasks.load() < maxMesherTasks &&
+           m_pendingMeshes.size() + (size_t) m_activeMesherTasks.load() <
+                   m_pendingMeshes.capacity();
+}
+
+void LevelRenderer::scheduleRebuild(const ChunkPos &pos, bool urgent)
+{
+    bool smoothLighting   = Lighting::isOn() && m_lightingMode == LightingMode::NEW;
+    bool grassSideOverlay = m_grassSideOverlayEnabled;
+    uint64_t generation   = 0;
+    uint64_t ticket       = 0;
+    CancellationToken token;
+
     {
-        ChunkPos pos;
-        bool haveTask       = false;
-        bool urgent         = false;
-        uint64_t generation = 0;
+        std::lock_guard<std::mutex> lock(m_rebuildQueueMutex);
+        uint64_t &requestedGeneration = m_requestedMeshGenerations[pos];
+        requestedGeneration++;
 
+        if (m_activeRebuilds.find(pos) != m_activeRebuilds.end())
         {
-            std::lock_guard<std::mutex> lock(m_rebuildQueueMutex);
-
-            if (!m_urgentQueue.empty())
+            if (urgent)
             {
-                pos = m_urgentQueue.front();
-                m_urgentQueue.pop();
-                m_urgentQueued.erase(pos);
-                haveTask = true;
-                urgent   = true;
+                m_deferredRebuilds.erase(pos);
+                m_deferredUrgentRebuilds.insert(pos);
             }
-            else if (!m_rebuildQueue.empty())
-            {
-                pos = m_rebuildQueue.front();
-                m_rebuildQueue.pop();
-                m_rebuildQueued.erase(pos);
-                haveTask = true;
-            }
-
-            if (haveTask)
+            else if (m_deferredUrgentRebuilds.find(pos) == m_deferredUrgentRebuilds.end())
             {
-                if (m_activeRebuilds.find(pos) != m_activeRebuilds.end())
-                {
-                    if (urgent)
-                    {
-                        m_deferredRebuilds.erase(pos);
-                        m_deferredUrgentRebuilds.insert(pos);
-                    }
-                    else if (m_deferredUrgentRebuilds.find(pos) == m_deferredUrgentRebuilds.end())
-                    {
-                        m_deferredRebuilds.insert(pos);
-                    }
-                    haveTask = false;
-                }
-                else
-                {
-                    m_activeRebuilds.insert(pos);
-                    generation = m_requestedMeshGenerations[pos];
-                }
+                m_deferredRebuilds.insert(pos);
             }
+            return;
         }
 
-        if (!haveTask)
-        {
-            break;
-        }
+        token = CancellationToken::create();
+        m_activeRebuilds.emplace(pos, token);
+        generation = requestedGeneration;
+        ticket     = m_nextMesherTicket++;
+        m_activeMesherTickets.insert(ticket);
+    }
 
-        const Chunk *chunk = m_level->getChunk(pos);
-        if (!chunk)
-        {
-            std::lock_guard<std::mutex> lock(m_rebuildQueueMutex);
-            m_activeRebuilds.erase(pos);
-            continue;
-        }
+    const Chunk *chunk = m_level->getChunk(pos);
+    if (!chunk)
+    {
+        std::lock_guard<std::mutex> lock(m_rebuildQueueMutex);
+        m_activeRebuilds.erase(pos);
+        m_activeMesherTickets.erase(ticket);
+        return;
+    }
 
-        m_activeMesherTasks.fetch_add(1);
+    m_activeMesherTasks.fetch_add(1);
 
-        m_mesherPool->detachTask([this, pos, chunk, smoothLighting, grassSideOverlay, generation] {
-            ThreadStorage::useDefaultThreadStorage();
-            if (m_mesherRunning)
-            {
+    JobSystem::get()->submit(
+            JobClass::MESHING,
+            [this, pos, chunk, smoothLighting, grassSideOverlay, generation, ticket, token] {
                 std::vector<ChunkMesher::MeshBuildResult> results;
-                ChunkMesher::buildMeshes(m_level, chunk, smoothLighting, grassSideOverlay,
-                                         &results);
-                submitMesh(pos, generation, std::move(results));
-            }
+                if (m_mesherRunning && !token.isCancelled() &&
+                    ChunkMesher::buildMeshes(m_level, chunk, smoothLighting, grassSideOverlay,
+                                             &results, token))
+                {
+                    submitMesh(pos, generation, std::move(results));
+                }
 
-            {
-                std::lock_guard<std::mutex> lock(m_rebuildQueueMutex);
-                m_activeRebuilds.erase(pos);
+                bool deferredUrgent = false;
+                bool deferred       = false;
+                {
+                    std::lock_guard<std::mutex> lock(m_rebuildQueueMutex);
+                    m_activeRebuilds.erase(pos);
+                    m_activeMesherTickets.erase(ticket);
+
+                    deferredUrgent = m_deferredUrgentRebuilds.erase(pos) != 0;
+                    deferred       = !deferredUrgent && m_deferredRebuilds.erase(pos) != 0;
+                }
 
-                if (m_deferredUrgentRebuilds.erase(pos) != 0)
+                if (deferredUrgent)
                 {
-                    if (m_urgentQueued.insert(pos).second)
-                    {
-                        m_urgentQueue.push(pos);
-                    }
+                    m_level->markChunkDirtyUrgent(pos);
                 }
-                else if (m_deferredRebuilds.erase(pos) != 0)
+                else if (deferred)
                 {
-                    if (m_rebuildQueued.insert(pos).second)
-                    {
-                        m_rebuildQueue.push(pos);
-                    }
+                    m_level->getDimension()->markChunkDirty(pos);
                 }
-            }
 
-            m_activeMesherTasks.fetch_sub(1);
-        });
-    }
+                m_activeMesherTasks.fetch_sub(1);
+            },
+            urgent ? 1 : 0, token);
 }
 
 void LevelRenderer::submitMesh(const ChunkPos &pos, uint64_t generation,
                                std::vector<ChunkMesher::MeshBuildResult> &&results)
 {
-    std::lock_guard<std::mutex> lock(m_meshQueueMutex);
-    m_pendingMeshes.push_back({pos, generation, std::move(results)});
+    m_pendingMeshes.push({pos, generation, std::move(results)});
 }
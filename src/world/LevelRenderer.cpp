@@ -14,7 +14,7 @@
 #include "../rendering/GlStateManager.h"
 #include "../rendering/RenderCommand.h"
 #include "../rendering/Tesselator.h"
-#include "../threading/ThreadStorage.h"
+#include "../threading/JobSystem.h"
 #include "../utils/Random.h"
 #include "../utils/Time.h"
 #include "../utils/math/Mth.h"
@@ -206,10 +206,8 @@ LevelRenderer::LevelRenderer(Level *level, int width, int height)
     colormapManager->load("sky", "textures/colormap/sky.png");
     colormapManager->load("foliage", "textures/colormap/foliage.png");
 
-    m_mesherRunning      = true;
-    size_t mesherThreads = (size_t) std::max(1u, std::thread::hardware_concurrency() - 2);
-    m_mesherPool         = std::make_unique<ThreadPool>(mesherThreads);
-    m_maxMesherTasks     = std::max((size_t) 1, (mesherThreads + 1) / 2);
+    m_mesherRunning  = true;
+    m_maxMesherTasks = JobSystem::get()->getConcurrencyCap(JobClass::MESHING);
 
     float skyLightClamp = LightSource::sampleSkyLightClamp(m_level->getDimensionTime());
     m_lightStorage.reset(skyLightClamp);
@@ -219,11 +217,15 @@ LevelRenderer::LevelRenderer(Level *level, int width, int height)
 LevelRenderer::~LevelRenderer()
 {
     m_mesherRunning = false;
-    if (m_mesherPool)
     {
-        m_mesherPool->wait();
-        m_mesherPool.reset();
+        std::lock_guard<std::mutex> lock(m_rebuildQueueMutex);
+        for (const auto &[pos, token] : m_activeRebuilds)
+        {
+            token.cancel();
+        }
     }
+    JobSystem::get()->waitForClass(JobClass::MESHING);
+    JobSystem::get()->waitForClass(JobClass::LIGHTING);
 
     if (m_sceneFramebuffer)
     {
@@ -317,11 +319,15 @@ void LevelRenderer::render(float partialTicks, Framebuffer *outputFramebuffer)
     renderStars(viewMatrix, projection);
 
     uploadPendingMeshes();
-    scheduleMesher();
     if (m_lightingMode == LightingMode::OLD && Lighting::isOn())
     {
         beginSkyLightClampUpdate(dimensionTime);
-        pumpSkyLightClampUpdate(64, 64);
+
+        FrameBudget &frameBudget = m_level->getFrameBudget();
+        int skyBudget            = frameBudget.beginPhase(FrameBudget::Phase::SKY_LIGHT,
+                                                          m_skyQueue.size() + m_skyResults.size());
+        frameBudget.endPhase(FrameBudget::Phase::SKY_LIGHT,
+                             pumpSkyLightClampUpdate(skyBudget, skyBudget));
     }
 
     std::vector<VisibleChunk> opaqueChunks;
@@ -408,10 +414,7 @@ void LevelRenderer::cycleLightingMode()
     m_lastSkyLightClamp = 255;
     m_skyQueue.clear();
     m_skyQueued.clear();
-    {
-        std::lock_guard<std::mutex> lock(m_skyMutex);
-        m_skyResults.clear();
-    }
+    m_skyResults.clear();
 
     Logger::logInfo("Lighting mode: %s",
                     m_lightingMode == LightingMode::NEW
@@ -426,7 +429,7 @@ void LevelRenderer::cycleLightingMode()
         const ChunkPos &pos                 = chunkIt->first;
         const std::unique_ptr<Chunk> &chunk = chunkIt->second;
         (void) chunk;
-        rebuildChunkUrgent(pos);
+        m_level->markChunkDirtyUrgent(pos);
     }
 }
 
@@ -465,7 +468,7 @@ void LevelRenderer::toggleGrassSideOverlay()
         const ChunkPos &pos                 = chunkIt->first;
         const std::unique_ptr<Chunk> &chunk = chunkIt->second;
         (void) chunk;
-        rebuildChunkUrgent(pos);
+        m_level->markChunkDirtyUrgent(pos);
     }
 }
 
@@ -481,11 +484,7 @@ size_t LevelRenderer::getSkyQueueCount() const { return m_skyQueue.size(); }
 
 size_t LevelRenderer::getMesherThreadCount() const
 {
-    if (!m_mesherPool)
-    {
-        return 0;
-    }
-    return m_mesherPool->getThreadCount();
+    return JobSystem::get()->getConcurrencyCap(JobClass::MESHING);
 }
 
 void LevelRenderer::updateLightState(const DimensionTime &dimensionTime)
@@ -1425,19 +1424,23 @@ void LevelRenderer::beginSkyLightClampUpdate(const DimensionTime &dimensionTime)
     }
 }
 
-void LevelRenderer::pumpSkyLightClampUpdate(int scheduleBudget, int applyBudget)
+int LevelRenderer::pumpSkyLightClampUpdate(int scheduleBudget, int applyBudget)
 {
     uint8_t clamp = m_skyClampTarget;
+    int processed = 0;
 
+    std::vector<std::function<void()>> skyJobs;
     while (scheduleBudget-- > 0)
     {
-        if (m_skyQueue.empty())
+        if (m_skyQueue.empty() ||
+            m_skyResults.size() + (size_t) m_activeSkyTasks.load() >= m_skyResults.capacity() / 2)
         {
             break;
         }
 
         ChunkPos pos = m_skyQueue.front();
         m_skyQueue.pop_front();
+        processed++;
 
         std::unordered_map<ChunkPos, std::vector<std::unique_ptr<ChunkMesh>>,
                            ChunkPosHash>::iterator it = m_chunks.find(pos);
@@ -1469,10 +1472,9 @@ void LevelRenderer::pumpSkyLightClampUpdate(int scheduleBudget, int applyBudget)
                 continue;
             }
 
-            m_mesherPool->detachTask([this, pos, i, id, clamp, rawLights = std::move(rawLights),
-                                      shades = std::move(shades),
-                                      tints  = std::move(tints)]() mutable {
-                ThreadStorage::useDefaultThreadStorage();
+            m_activeSkyTasks.fetch_add(1);
+            skyJobs.push_back([this, pos, i, id, clamp, rawLights = std::move(rawLights),
+                               shades = std::move(shades), tints = std::move(tints)] {
                 size_t vc = rawLights.size();
                 std::vector<uint8_t> lightData;
                 lightData.resize(vc * 3);
@@ -1535,27 +1537,22 @@ void LevelRenderer::pumpSkyLightClampUpdate(int scheduleBudget, int applyBudget)
                 result.meshId    = id;
                 result.lightData = std::move(lightData);
 
-                std::lock_guard<std::mutex> lock(m_skyMutex);
-
-                m_skyResults.push_back(std::move(result));
+                m_skyResults.push(std::move(result));
+                m_activeSkyTasks.fetch_sub(1);
             });
         }
     }
 
+    JobSystem::get()->submitBatch(JobClass::LIGHTING, skyJobs);
+
     while (applyBudget-- > 0)
     {
         SkyUpdateResult result;
+        if (!m_skyResults.tryPop(&result))
         {
-            std::lock_guard<std::mutex> lock(m_skyMutex);
-
-            if (m_skyResults.empty())
-            {
-                break;
-            }
-
-            result = std::move(m_skyResults.front());
-            m_skyResults.pop_front();
+            break;
         }
+        processed++;
 
         std::unordered_map<ChunkPos, std::vector<std::unique_ptr<ChunkMesh>>,
                            ChunkPosHash>::iterator it = m_chunks.find(result.pos);
@@ -1577,7 +1574,10 @@ void LevelRenderer::pumpSkyLightClampUpdate(int scheduleBudget, int applyBudget)
         }
         mesh->applySky(std::move(result.lightData));
     }
+
+    return processed;
 }
+
 std::vector<uint8_t> LevelRenderer::buildCloudMap()
 {
     std::vector<uint8_t> cloudMap = MemoryTracker::getInstance()->createByteBuffer(256 * 256);
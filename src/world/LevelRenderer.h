@@ -6,7 +6,7 @@
 #include <deque>
 #include <memory>
 #include <mutex>
-#include <queue>
+#include <set>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -15,11 +15,13 @@
 #include "../rendering/Framebuffer.h"
 #include "../rendering/Shader.h"
 #include "../scene/culling/FrustumCuller.h"
-#include "../threading/ThreadPool.h"
+#include "../threading/CancellationToken.h"
+#include "../threading/MpscQueue.h"
 #include "Level.h"
 #include "chunk/ChunkMesh.h"
 #include "chunk/ChunkMesher.h"
 #include "chunk/ChunkPos.h"
+#include "chunk/ChunkPriority.h"
 #include "environment/CloudMesh.h"
 #include "lighting/LightCache.h"
 #include "lighting/LightStorage.h"
@@ -49,8 +51,11 @@ public:
     void renderDynamicLightImGui();
 
     void rebuild();
-    void rebuildChunk(const ChunkPos &pos);
-    void rebuildChunkUrgent(const ChunkPos &pos);
+    int scheduleRebuilds(const ChunkPriority &priority, bool urgent, int maxRebuilds);
+    void rebuildCommittedChunk(const ChunkPos &pos);
+    void dropChunk(const ChunkPos &pos);
+    uint64_t getMesherRetireTicket() const;
+    bool isMesherTicketRetired(uint64_t ticket) const;
     void cycleLightingMode();
     void cycleBlockOutlineMode();
     void toggleGrassSideOverlay();
@@ -63,8 +68,8 @@ public:
     size_t getVisibleChunkCount() const;
     size_t getRenderedMeshCount() const;
     size_t getPendingMeshCount() const;
-    size_t getQueuedRebuildCount() const;
-    size_t getUrgentRebuildCount() const;
+    size_t getActiveRebuildCount() const;
+    size_t getDeferredRebuildCount() const;
     size_t getSkyQueueCount() const;
     size_t getMesherThreadCount() const;
 
@@ -148,11 +153,12 @@ private:
     void renderEntityNameTags(float partialTicks);
     void renderFogPass(const Mat4 &projection, Framebuffer *sourceFramebuffer);
 
-    void scheduleMesher();
+    bool hasMesherCapacity() const;
+    void scheduleRebuild(const ChunkPos &pos, bool urgent);
 
     void updateLightState(const DimensionTime &dimensionTime);
     void beginSkyLightClampUpdate(const DimensionTime &dimensionTime);
-    void pumpSkyLightClampUpdate(int scheduleBudget, int applyBudget);
+    int pumpSkyLightClampUpdate(int scheduleBudget, int applyBudget);
     float getChunkFadeAlpha(const ChunkPos &pos, float delta);
     void tickHiddenChunkFadeState(const ChunkPos &pos, float delta);
     Vec3 sampleDynamicLightRgb(const Vec3 &samplePos) const;
@@ -192,8 +198,8 @@ private:
     LightCache m_lightCache;
     std::vector<DynamicLightPipeline::PackedLight> m_forwardDynamicLights;
 
-    std::mutex m_skyMutex;
-    std::deque<SkyUpdateResult> m_skyResults;
+    MpscQueue<SkyUpdateResult> m_skyResults{4096};
+    std::atomic<int> m_activeSkyTasks{0};
     std::deque<ChunkPos> m_skyQueue;
     std::unordered_set<ChunkPos, ChunkPosHash> m_skyQueued;
     uint8_t m_skyClampTarget{15};
@@ -203,11 +209,9 @@ private:
     ChunkFadeSettings m_chunkFadeSettings{0.20f, 0.12f};
     size_t m_lastVisibleChunkCount{0};
     size_t m_lastRenderedMeshCount{0};
-    mutable std::mutex m_meshQueueMutex;
-    std::deque<PendingMeshUpload> m_pendingMeshes;
+    MpscQueue<PendingMeshUpload> m_pendingMeshes{256};
     std::unordered_map<ChunkPos, ReadyMeshSwap, ChunkPosHash> m_readyMeshes;
 
-    std::unique_ptr<ThreadPool> m_mesherPool;
     std::atomic<bool> m_mesherRunning{false};
     std::atomic<int> m_activeMesherTasks{0};
     size_t m_maxMesherTasks{1};
@@ -217,12 +221,10 @@ private:
     BlockOutlineMode m_blockOutlineMode;
 
     mutable std::mutex m_rebuildQueueMutex;
-    std::queue<ChunkPos> m_rebuildQueue;
-    std::queue<ChunkPos> m_urgentQueue;
-    std::unordered_set<ChunkPos, ChunkPosHash> m_rebuildQueued;
-    std::unordered_set<ChunkPos, ChunkPosHash> m_urgentQueued;
-    std::unordered_set<ChunkPos, ChunkPosHash> m_activeRebuilds;
+    std::unordered_map<ChunkPos, CancellationToken, ChunkPosHash> m_activeRebuilds;
     std::unordered_set<ChunkPos, ChunkPosHash> m_deferredRebuilds;
     std::unordered_set<ChunkPos, ChunkPosHash> m_deferredUrgentRebuilds;
     std::unordered_map<ChunkPos, uint64_t, ChunkPosHash> m_requestedMeshGenerations;
+    std::set<uint64_t> m_activeMesherTickets;
+    uint64_t m_nextMesherTicket{0};
 };
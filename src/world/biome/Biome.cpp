@@ -1,7 +1,9 @@
 #include "Biome.h"
 #include "BiomeRegistry.h"
 
-Biome::Biome(const std::string &name) : m_name(name) {}
+#include "../block/BlockRegistry.h"
+
+Biome::Biome(const std::string &name) : m_name(name), m_topBlockId(), m_fillerBlockId() {}
 
 Biome::~Biome() {}
 
@@ -10,3 +12,13 @@ Biome *Biome::byId(uint32_t id) { return BiomeRegistry::get()->byId(id); }
 Biome *Biome::byName(const std::string &name) { return byId(BiomeRegistry::get()->getId(name)); }
 
 const std::string &Biome::getName() const { return m_name; }
+
+void Biome::resolveBlockIds()
+{
+    m_topBlockId    = BlockId(BlockRegistry::get()->idOf(getTopBlock()));
+    m_fillerBlockId = BlockId(BlockRegistry::get()->idOf(getFillerBlock()));
+}
+
+BlockId Biome::getTopBlockId() const { return m_topBlockId; }
+
+BlockId Biome::getFillerBlockId() const { return m_fillerBlockId; }
@@ -3,6 +3,8 @@
 #include <cstdint>
 #include <string>
 
+#include "../block/BlockId.h"
+
 class Block;
 
 class Biome
@@ -19,6 +21,10 @@ public:
     virtual Block *getTopBlock() const    = 0;
     virtual Block *getFillerBlock() const = 0;
 
+    void resolveBlockIds();
+    BlockId getTopBlockId() const;
+    BlockId getFillerBlockId() const;
+
     virtual int getBaseHeight() const      = 0;
     virtual int getHeightVariation() const = 0;
 
@@ -27,4 +33,6 @@ public:
 
 private:
     std::string m_name;
+    BlockId m_topBlockId;
+    BlockId m_fillerBlockId;
 };
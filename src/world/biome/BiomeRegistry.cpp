@@ -2,6 +2,7 @@
 
 #include "BiomeDesert.h"
 #include "BiomePlains.h"
+#include "Biomes.h"
 
 BiomeRegistry *BiomeRegistry::get()
 {
@@ -12,6 +13,13 @@ BiomeRegistry *BiomeRegistry::get()
 void BiomeRegistry::init()
 {
     BiomeRegistry *registry = get();
-    registry->registerValue("plains", new BiomePlains());
-    registry->registerValue("desert", new BiomeDesert());
+    Biomes::PLAINS          = new BiomePlains();
+    Biomes::DESERT          = new BiomeDesert();
+    registry->registerValue("plains", Biomes::PLAINS);
+    registry->registerValue("desert", Biomes::DESERT);
+
+    for (uint32_t i = 0; i < registry->size(); i++)
+    {
+        registry->byId(i)->resolveBlockIds();
+    }
 }
@@ -0,0 +1,4 @@
+#include "Biomes.h"
+
+Biome *Biomes::PLAINS = nullptr;
+Biome *Biomes::DESERT = nullptr;
@@ -0,0 +1,10 @@
+#pragma once
+
+#include "Biome.h"
+
+class Biomes
+{
+public:
+    static Biome *PLAINS;
+    static Biome *DESERT;
+};
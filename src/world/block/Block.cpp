@@ -13,7 +13,11 @@ Block::Block()
       m_interactionAttachmentOffset(0.0f), m_lightEmission(0), m_lightR(0), m_lightG(0),
       m_lightB(0), m_renderShape(RenderShape::CUBE), m_hasWallMountedTransform(false),
       m_wallMountedTiltDegrees(0.0f), m_wallMountedInset(0.0f)
-{}
+{
+    m_textures.fill(nullptr);
+    m_uvRects.fill({0.0f, 0.0f, 1.0f, 1.0f});
+    m_atlasUvRects.fill({0.0f, 0.0f, 1.0f, 1.0f});
+}
 
 Block::Block(const std::string &name, bool solid, const std::string &texturePath)
     : m_name(name), m_solid(solid), m_selectable(true),
@@ -24,6 +28,9 @@ Block::Block(const std::string &name, bool solid, const std::string &texturePath
     m_interactionAabb             = m_aabb;
     m_hasInteractionAabb          = false;
     m_interactionAttachmentOffset = 0.0f;
+    m_textures.fill(nullptr);
+    m_uvRects.fill({0.0f, 0.0f, 1.0f, 1.0f});
+    m_atlasUvRects.fill({0.0f, 0.0f, 1.0f, 1.0f});
     if (!texturePath.empty())
     {
         TextureRepository *textureRepo = BlockRegistry::getTextureRepository();
@@ -64,65 +71,38 @@ void Block::tick(Level *level, const BlockPos &pos)
     (void) pos;
 }
 
-void Block::setTexture(Direction *direction, Texture *texture) { m_textures[direction] = texture; }
-
-Texture *Block::getTexture(Direction *direction) const
+void Block::setTexture(Direction *direction, Texture *texture)
 {
-    std::unordered_map<Direction *, Texture *>::const_iterator it = m_textures.find(direction);
-    if (it == m_textures.end())
-    {
-        return nullptr;
-    }
-    return it->second;
+    m_textures[direction->ordinal] = texture;
 }
 
+Texture *Block::getTexture(Direction *direction) const { return m_textures[direction->ordinal]; }
+
 void Block::setTexturePath(Direction *direction, const std::string &path)
 {
-    m_texturePaths[direction] = path;
+    m_texturePaths[direction->ordinal] = path;
 }
 
 const std::string &Block::getTexturePath(Direction *direction) const
 {
-    std::unordered_map<Direction *, std::string>::const_iterator it =
-            m_texturePaths.find(direction);
-    static const std::string empty;
-    if (it == m_texturePaths.end())
-    {
-        return empty;
-    }
-    return it->second;
+    return m_texturePaths[direction->ordinal];
 }
 
-void Block::setTintColormap(const std::string &colormapName)
-{
-    m_tintColormaps[Direction::UP]    = colormapName;
-    m_tintColormaps[Direction::DOWN]  = colormapName;
-    m_tintColormaps[Direction::NORTH] = colormapName;
-    m_tintColormaps[Direction::SOUTH] = colormapName;
-    m_tintColormaps[Direction::EAST]  = colormapName;
-    m_tintColormaps[Direction::WEST]  = colormapName;
-}
+void Block::setTintColormap(const std::string &colormapName) { m_tintColormaps.fill(colormapName); }
 
 void Block::setTintColormap(Direction *direction, const std::string &colormapName)
 {
-    m_tintColormaps[direction] = colormapName;
+    m_tintColormaps[direction->ordinal] = colormapName;
 }
 
 bool Block::hasTintColormap(Direction *direction) const
 {
-    return m_tintColormaps.find(direction) != m_tintColormaps.end();
+    return !m_tintColormaps[direction->ordinal].empty();
 }
 
 const std::string &Block::getTintColormap(Direction *direction) const
 {
-    std::unordered_map<Direction *, std::string>::const_iterator it =
-            m_tintColormaps.find(direction);
-    static const std::string empty;
-    if (it == m_tintColormaps.end())
-    {
-        return empty;
-    }
-    return it->second;
+    return m_tintColormaps[direction->ordinal];
 }
 
 uint32_t Block::resolveTint(Direction *direction, Level *level, const Chunk *chunk, int localX,
@@ -289,33 +269,19 @@ Block::RenderShape Block::getRenderShape() const { return m_renderShape; }
 
 void Block::setUVRect(Direction *direction, float u0, float v0, float u1, float v1)
 {
-    m_uvRects[direction] = {u0, v0, u1, v1};
+    m_uvRects[direction->ordinal] = {u0, v0, u1, v1};
 }
 
-Block::UVRect Block::getUVRect(Direction *direction) const
-{
-    std::unordered_map<Direction *, UVRect>::const_iterator it = m_uvRects.find(direction);
-    if (it == m_uvRects.end())
-    {
-        return {0.0f, 0.0f, 1.0f, 1.0f};
-    }
-    return it->second;
-}
+Block::UVRect Block::getUVRect(Direction *direction) const { return m_uvRects[direction->ordinal]; }
 
 void Block::setAtlasUVRect(Direction *direction, float u0, float v0, float u1, float v1)
 {
-    m_atlasUvRects[direction] = {u0, v0, u1, v1};
+    m_atlasUvRects[direction->ordinal] = {u0, v0, u1, v1};
 }
 
 Block::UVRect Block::getAtlasUVRect(Direction *direction) const
 {
-    std::unordered_map<Direction *, UVRect>::const_iterator it =
-            m_atlasUvRects.find(direction);
-    if (it == m_atlasUvRects.end())
-    {
-        return {0.0f, 0.0f, 1.0f, 1.0f};
-    }
-    return it->second;
+    return m_atlasUvRects[direction->ordinal];
 }
 
 void Block::setWallMountedTransform(float tiltDegrees, float wallInset)
@@ -1,8 +1,8 @@
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include <string>
-#include <unordered_map>
 
 #include "../../rendering/Texture.h"
 #include "../../utils/AABB.h"
@@ -88,9 +88,9 @@ public:
     float getWallMountedInset() const;
 
 protected:
-    std::unordered_map<Direction *, Texture *> m_textures;
-    std::unordered_map<Direction *, std::string> m_texturePaths;
-    std::unordered_map<Direction *, std::string> m_tintColormaps;
+    std::array<Texture *, Direction::COUNT> m_textures;
+    std::array<std::string, Direction::COUNT> m_texturePaths;
+    std::array<std::string, Direction::COUNT> m_tintColormaps;
     std::string m_name;
     bool m_solid;
     bool m_selectable;
@@ -103,8 +103,8 @@ protected:
     uint8_t m_lightG;
     uint8_t m_lightB;
     RenderShape m_renderShape;
-    std::unordered_map<Direction *, UVRect> m_uvRects;
-    std::unordered_map<Direction *, UVRect> m_atlasUvRects;
+    std::array<UVRect, Direction::COUNT> m_uvRects;
+    std::array<UVRect, Direction::COUNT> m_atlasUvRects;
     bool m_hasWallMountedTransform;
     float m_wallMountedTiltDegrees;
     float m_wallMountedInset;
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdint>
+
+class Block;
+
+class BlockId
+{
+public:
+    constexpr BlockId() : m_id(0) {}
+    explicit constexpr BlockId(uint32_t id) : m_id(id) {}
+
+    constexpr uint32_t getId() const { return m_id; }
+    Block *getBlock() const;
+
+    constexpr bool operator==(const BlockId &other) const { return m_id == other.m_id; }
+    constexpr bool operator!=(const BlockId &other) const { return m_id != other.m_id; }
+
+private:
+    uint32_t m_id;
+};
@@ -0,0 +1,44 @@
+#include "BlockProperties.h"
+
+#include <cstdlib>
+
+#include "../../core/Logger.h"
+
+void BlockProperties::build(const MappedRegistry<Block *> &registry)
+{
+    if (registry.size() > MAX_BLOCKS)
+    {
+        Logger::logError("Block property tables hold %d blocks, registry has %d",
+                         (int) MAX_BLOCKS, (int) registry.size());
+        std::abort();
+    }
+
+    s_solid.reset();
+    s_opaque.reset();
+    s_selectable.reset();
+
+    for (uint32_t id = 0; id < registry.size(); id++)
+    {
+        Block *block = registry.byId(id);
+        if (!block)
+        {
+            continue;
+        }
+
+        Block::RenderShape shape = block->getRenderShape();
+        s_solid[id]              = block->isSolid();
+        s_opaque[id]             = block->isSolid() && shape == Block::RenderShape::CUBE;
+        s_selectable[id]         = block->isSelectable();
+        s_lightEmission[id]      = block->getLightEmission();
+        s_renderShape[id]        = shape;
+
+        LightColor &color = s_lightColor[id];
+        block->getLightColor(&color.r, &color.g, &color.b);
+
+        for (int face = 0; face < Direction::COUNT; face++)
+        {
+            Direction *direction = Direction::byOrdinal(face);
+            s_faces[id][face]    = {block->getTexture(direction), block->getAtlasUVRect(direction)};
+        }
+    }
+}
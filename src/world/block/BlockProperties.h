@@ -0,0 +1,69 @@
+#pragma once
+
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+
+#include "../../utils/Direction.h"
+#include "../../utils/MappedRegistry.h"
+#include "Block.h"
+
+struct BlockFace
+{
+    Texture *texture;
+    Block::UVRect atlasRect;
+};
+
+class BlockProperties
+{
+public:
+    static constexpr size_t MAX_BLOCKS = 256;
+
+    static void build(const MappedRegistry<Block *> &registry);
+
+    static bool isSolid(uint32_t id) { return id < MAX_BLOCKS && s_solid[id]; }
+
+    static bool isOpaque(uint32_t id) { return id < MAX_BLOCKS && s_opaque[id]; }
+
+    static bool isSelectable(uint32_t id) { return id < MAX_BLOCKS && s_selectable[id]; }
+
+    static uint8_t getLightEmission(uint32_t id)
+    {
+        return id < MAX_BLOCKS ? s_lightEmission[id] : 0;
+    }
+
+    static void getLightColor(uint32_t id, uint8_t *r, uint8_t *g, uint8_t *b)
+    {
+        const LightColor &color = s_lightColor[id < MAX_BLOCKS ? id : 0];
+        *r                      = color.r;
+        *g                      = color.g;
+        *b                      = color.b;
+    }
+
+    static Block::RenderShape getRenderShape(uint32_t id)
+    {
+        return id < MAX_BLOCKS ? s_renderShape[id] : Block::RenderShape::CUBE;
+    }
+
+    static const BlockFace &getFace(uint32_t id, Direction *direction)
+    {
+        return s_faces[id < MAX_BLOCKS ? id : 0][direction->ordinal];
+    }
+
+private:
+    struct LightColor
+    {
+        uint8_t r;
+        uint8_t g;
+        uint8_t b;
+    };
+
+    static inline std::bitset<MAX_BLOCKS> s_solid;
+    static inline std::bitset<MAX_BLOCKS> s_opaque;
+    static inline std::bitset<MAX_BLOCKS> s_selectable;
+    static inline uint8_t s_lightEmission[MAX_BLOCKS]{};
+    static inline LightColor s_lightColor[MAX_BLOCKS]{};
+    static inline Block::RenderShape s_renderShape[MAX_BLOCKS]{};
+    static inline std::array<BlockFace, Direction::COUNT> s_faces[MAX_BLOCKS]{};
+};
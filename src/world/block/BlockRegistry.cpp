@@ -3,6 +3,8 @@
 #include <unordered_set>
 
 #include "../../utils/Direction.h"
+#include "BlockProperties.h"
+#include "Blocks.h"
 
 static TextureRepository s_textures;
 static TextureAtlas s_blockAtlas;
@@ -13,6 +15,61 @@ static void setBlockTexture(Block &block, Direction *direction, const std::strin
     block.setTexturePath(direction, path);
 }
 
+static void buildBlockAtlas(BlockRegistry *registry)
+{
+    static Direction *directions[] = {Direction::UP,    Direction::DOWN, Direction::NORTH,
+                                      Direction::SOUTH, Direction::EAST, Direction::WEST};
+    std::vector<std::string> atlasPaths;
+    std::unordered_set<std::string> seenPaths;
+
+    for (uint32_t i = 0; i < registry->size(); i++)
+    {
+        Block *block = registry->byId(i);
+        if (!block)
+        {
+            continue;
+        }
+
+        for (Direction *direction : directions)
+        {
+            const std::string &path = block->getTexturePath(direction);
+            if (!path.empty() && seenPaths.insert(path).second)
+            {
+                atlasPaths.push_back(path);
+            }
+        }
+    }
+
+    s_blockAtlas.build(&s_textures, atlasPaths);
+    Texture *atlasTexture = s_blockAtlas.getTexture();
+    if (!atlasTexture)
+    {
+        return;
+    }
+
+    for (uint32_t i = 0; i < registry->size(); i++)
+    {
+        Block *block = registry->byId(i);
+        if (!block)
+        {
+            continue;
+        }
+
+        for (Direction *direction : directions)
+        {
+            const std::string &path = block->getTexturePath(direction);
+            if (path.empty() || !s_blockAtlas.has(path))
+            {
+                continue;
+            }
+
+            TextureAtlas::Region region = s_blockAtlas.get(path);
+            block->setTexture(direction, atlasTexture);
+            block->setAtlasUVRect(direction, region.u0, region.v0, region.u1, region.v1);
+        }
+    }
+}
+
 BlockRegistry *BlockRegistry::get()
 {
     static BlockRegistry instance;
@@ -78,71 +135,22 @@ void BlockRegistry::init()
     s_air.setSelectable(false);
     s_worldBorder.setSelectable(false);
 
-    registry->registerValue("air", &s_air);
-    registry->registerValue("world_border", &s_worldBorder);
-    registry->registerValue("bedrock", &s_bedrock);
-    registry->registerValue("stone", &s_stone);
-    registry->registerValue("cobblestone", &s_cobblestone);
-    registry->registerValue("andesite", &s_andesite);
-    registry->registerValue("dirt", &s_dirt);
-    registry->registerValue("grass", &s_grass);
-    registry->registerValue("sand", &s_sand);
-    registry->registerValue("gravel", &s_gravel);
-    registry->registerValue("glowstone", &s_glowstone);
-    registry->registerValue("torch", &s_torch);
-    registry->registerValue("torch_wall", &s_torchWall);
-
-    static Direction *directions[] = {Direction::UP,    Direction::DOWN, Direction::NORTH,
-                                      Direction::SOUTH, Direction::EAST, Direction::WEST};
-    std::vector<std::string> atlasPaths;
-    std::unordered_set<std::string> seenPaths;
-
-    for (uint32_t i = 0; i < registry->size(); i++)
-    {
-        Block *block = registry->byId(i);
-        if (!block)
-        {
-            continue;
-        }
-
-        for (Direction *direction : directions)
-        {
-            const std::string &path = block->getTexturePath(direction);
-            if (!path.empty() && seenPaths.insert(path).second)
-            {
-                atlasPaths.push_back(path);
-            }
-        }
-    }
-
-    s_blockAtlas.build(&s_textures, atlasPaths);
-    Texture *atlasTexture = s_blockAtlas.getTexture();
-    if (!atlasTexture)
-    {
-        return;
-    }
-
-    for (uint32_t i = 0; i < registry->size(); i++)
-    {
-        Block *block = registry->byId(i);
-        if (!block)
-        {
-            continue;
-        }
-
-        for (Direction *direction : directions)
-        {
-            const std::string &path = block->getTexturePath(direction);
-            if (path.empty() || !s_blockAtlas.has(path))
-            {
-                continue;
-            }
-
-            TextureAtlas::Region region = s_blockAtlas.get(path);
-            block->setTexture(direction, atlasTexture);
-            block->setAtlasUVRect(direction, region.u0, region.v0, region.u1, region.v1);
-        }
-    }
+    Blocks::AIR          = BlockId(registry->registerValue("air", &s_air));
+    Blocks::WORLD_BORDER = BlockId(registry->registerValue("world_border", &s_worldBorder));
+    Blocks::BEDROCK      = BlockId(registry->registerValue("bedrock", &s_bedrock));
+    Blocks::STONE        = BlockId(registry->registerValue("stone", &s_stone));
+    Blocks::COBBLESTONE  = BlockId(registry->registerValue("cobblestone", &s_cobblestone));
+    Blocks::ANDESITE     = BlockId(registry->registerValue("andesite", &s_andesite));
+    Blocks::DIRT         = BlockId(registry->registerValue("dirt", &s_dirt));
+    Blocks::GRASS        = BlockId(registry->registerValue("grass", &s_grass));
+    Blocks::SAND         = BlockId(registry->registerValue("sand", &s_sand));
+    Blocks::GRAVEL       = BlockId(registry->registerValue("gravel", &s_gravel));
+    Blocks::GLOWSTONE    = BlockId(registry->registerValue("glowstone", &s_glowstone));
+    Blocks::TORCH        = BlockId(registry->registerValue("torch", &s_torch));
+    Blocks::TORCH_WALL   = BlockId(registry->registerValue("torch_wall", &s_torchWall));
+
+    buildBlockAtlas(registry);
+    BlockProperties::build(*registry);
 }
 
 TextureRepository *BlockRegistry::getTextureRepository() { return &s_textures; }
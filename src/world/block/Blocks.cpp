@@ -0,0 +1,19 @@
+#include "Blocks.h"
+
+#include "Block.h"
+
+BlockId Blocks::AIR;
+BlockId Blocks::WORLD_BORDER;
+BlockId Blocks::BEDROCK;
+BlockId Blocks::STONE;
+BlockId Blocks::COBBLESTONE;
+BlockId Blocks::ANDESITE;
+BlockId Blocks::DIRT;
+BlockId Blocks::GRASS;
+BlockId Blocks::SAND;
+BlockId Blocks::GRAVEL;
+BlockId Blocks::GLOWSTONE;
+BlockId Blocks::TORCH;
+BlockId Blocks::TORCH_WALL;
+
+Block *BlockId::getBlock() const { return Block::byId(m_id); }
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "BlockId.h"
+
+class Blocks
+{
+public:
+    static BlockId AIR;
+    static BlockId WORLD_BORDER;
+    static BlockId BEDROCK;
+    static BlockId STONE;
+    static BlockId COBBLESTONE;
+    static BlockId ANDESITE;
+    static BlockId DIRT;
+    static BlockId GRASS;
+    static BlockId SAND;
+    static BlockId GRAVEL;
+    static BlockId GLOWSTONE;
+    static BlockId TORCH;
+    static BlockId TORCH_WALL;
+};
@@ -1,8 +1,13 @@
 #include "Chunk.h"
 
+#include <algorithm>
+#include <iterator>
+
+#include "../biome/BiomeRegistry.h"
 #include "../block/BlockRegistry.h"
 
-Chunk::Chunk(const ChunkPos &pos) : m_pos(pos), m_needsRelight(true)
+Chunk::Chunk(const ChunkPos &pos)
+    : m_pos(pos), m_needsRelight(true), m_unmodified(false), m_meshDirty(0)
 {
     for (int i = 0; i < SIZE_X * SIZE_Y * SIZE_Z; i++)
     {
@@ -30,6 +35,38 @@ void Chunk::setBlock(int x, int y, int z, Block *block)
     m_blockAttachmentFaces[i] = 0;
 }
 
+void Chunk::setBlockId(int x, int y, int z, uint32_t id)
+{
+    int i                     = index(x, y, z);
+    m_blocks[i]               = id;
+    m_blockAttachmentFaces[i] = 0;
+}
+
+void Chunk::fillColumn(int x, int z, int minY, int maxY, uint32_t id)
+{
+    if (minY < 0)
+    {
+        minY = 0;
+    }
+    if (maxY >= SIZE_Y)
+    {
+        maxY = SIZE_Y - 1;
+    }
+
+    int i = index(x, minY, z);
+    for (int y = minY; y <= maxY; y++, i += SIZE_X)
+    {
+        m_blocks[i]               = id;
+        m_blockAttachmentFaces[i] = 0;
+    }
+}
+
+void Chunk::fill(uint32_t id)
+{
+    std::fill(std::begin(m_blocks), std::end(m_blocks), id);
+    std::fill(std::begin(m_blockAttachmentFaces), std::end(m_blockAttachmentFaces), 0);
+}
+
 uint8_t Chunk::getBlockAttachmentFace(int x, int y, int z) const
 {
     return m_blockAttachmentFaces[index(x, y, z)];
@@ -42,6 +79,22 @@ void Chunk::setBlockAttachmentFace(int x, int y, int z, uint8_t face)
 
 const ChunkPos &Chunk::getPos() const { return m_pos; }
 
+void Chunk::setUnmodified(bool unmodified) { m_unmodified = unmodified; }
+
+bool Chunk::isUnmodified() const { return m_unmodified; }
+
+bool Chunk::markMeshDirty(uint8_t flag)
+{
+    return !(m_meshDirty.fetch_or(flag, std::memory_order_acq_rel) & flag);
+}
+
+void Chunk::clearMeshDirty(uint8_t flag)
+{
+    m_meshDirty.fetch_and((uint8_t) ~flag, std::memory_order_acq_rel);
+}
+
+bool Chunk::isMeshDirty() const { return m_meshDirty.load(std::memory_order_acquire) != 0; }
+
 int Chunk::columnIndex(int x, int z) const { return x + SIZE_X * z; }
 
 void Chunk::setBiomeAt(int x, int z, Biome *biome) { m_columnBiomes[columnIndex(x, z)] = biome; }
@@ -89,4 +142,42 @@ uint8_t Chunk::getSkyLight(int x, int y, int z) const { return m_skyLight[index(
 
 void Chunk::setSkyLight(int x, int y, int z, uint8_t level) { m_skyLight[index(x, y, z)] = level; }
 
+void Chunk::write(std::ostream &out) const
+{
+    out.write((const char *) m_blocks, sizeof(m_blocks));
+    out.write((const char *) m_blockAttachmentFaces, sizeof(m_blockAttachmentFaces));
+    out.write((const char *) m_blockLight, sizeof(m_blockLight));
+    out.write((const char *) m_skyLight, sizeof(m_skyLight));
+
+    uint32_t biomeIds[SIZE_X * SIZE_Z];
+    for (int i = 0; i < SIZE_X * SIZE_Z; i++)
+    {
+        biomeIds[i] =
+                m_columnBiomes[i] ? BiomeRegistry::get()->idOf(m_columnBiomes[i]) : UINT32_MAX;
+    }
+    out.write((const char *) biomeIds, sizeof(biomeIds));
+}
+
+bool Chunk::read(std::istream &in)
+{
+    uint32_t biomeIds[SIZE_X * SIZE_Z];
+
+    in.read((char *) m_blocks, sizeof(m_blocks));
+    in.read((char *) m_blockAttachmentFaces, sizeof(m_blockAttachmentFaces));
+    in.read((char *) m_blockLight, sizeof(m_blockLight));
+    in.read((char *) m_skyLight, sizeof(m_skyLight));
+    in.read((char *) biomeIds, sizeof(biomeIds));
+    if (!in)
+    {
+        return false;
+    }
+
+    for (int i = 0; i < SIZE_X * SIZE_Z; i++)
+    {
+        m_columnBiomes[i] = BiomeRegistry::get()->byId(biomeIds[i]);
+    }
+
+    return true;
+}
+
 int Chunk::index(int x, int y, int z) const { return x + SIZE_X * (y + SIZE_Y * z); }
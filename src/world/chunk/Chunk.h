@@ -1,6 +1,9 @@
 #pragma once
 
+#include <atomic>
 #include <cstdint>
+#include <istream>
+#include <ostream>
 
 #include "../biome/Biome.h"
 #include "../block/Block.h"
@@ -13,15 +16,28 @@ public:
     static constexpr int SIZE_Y = 256;
     static constexpr int SIZE_Z = 16;
 
+    static constexpr uint8_t MESH_DIRTY        = 1;
+    static constexpr uint8_t MESH_DIRTY_URGENT = 2;
+
     explicit Chunk(const ChunkPos &pos);
 
     uint32_t getBlockId(int x, int y, int z) const;
     void setBlock(int x, int y, int z, Block *block);
+    void setBlockId(int x, int y, int z, uint32_t id);
+    void fillColumn(int x, int z, int minY, int maxY, uint32_t id);
+    void fill(uint32_t id);
     uint8_t getBlockAttachmentFace(int x, int y, int z) const;
     void setBlockAttachmentFace(int x, int y, int z, uint8_t face);
 
     const ChunkPos &getPos() const;
 
+    void setUnmodified(bool unmodified);
+    bool isUnmodified() const;
+
+    bool markMeshDirty(uint8_t flag);
+    void clearMeshDirty(uint8_t flag);
+    bool isMeshDirty() const;
+
     void setBiomeAt(int x, int z, Biome *biome);
     Biome *getBiomeAt(int x, int z) const;
 
@@ -34,6 +50,9 @@ public:
     uint8_t getSkyLight(int x, int y, int z) const;
     void setSkyLight(int x, int y, int z, uint8_t level);
 
+    void write(std::ostream &out) const;
+    bool read(std::istream &in);
+
 private:
     int index(int x, int y, int z) const;
     int columnIndex(int x, int z) const;
@@ -52,6 +71,8 @@ private:
     LightData m_blockLight[SIZE_X * SIZE_Y * SIZE_Z];
     uint8_t m_skyLight[SIZE_X * SIZE_Y * SIZE_Z];
     bool m_needsRelight;
+    bool m_unmodified;
+    std::atomic<uint8_t> m_meshDirty;
 
     Biome *m_columnBiomes[SIZE_X * SIZE_Z];
 };
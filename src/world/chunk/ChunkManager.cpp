@@ -1,8 +1,10 @@
 #include "ChunkManager.h"
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <queue>
+#include <thread>
 
 #ifndef _WIN32
 #include <sys/resource.h>
@@ -11,17 +13,19 @@
 
 #include "../../core/Logger.h"
 #include "../../core/Minecraft.h"
-#include "../../threading/ThreadStorage.h"
-#include "../../utils/math/Mth.h"
+#include "../../threading/JobSystem.h"
 #include "../LevelRenderer.h"
-#include "../block/Block.h"
+#include "../block/BlockProperties.h"
+#include "../block/Blocks.h"
 #include "../chunk/ChunkMesher.h"
 #include "../generation/TerrainGenerator.h"
 #include "../lighting/LightEngine.h"
+#include "storage/ChunkStorage.h"
 
 ChunkManager::ChunkManager(Level *level)
-    : m_level(level), m_running(false), m_active(0), m_maxActive(0),
-      m_lastPlayerChunk{INT32_MAX, INT32_MAX, INT32_MAX}, m_centerX(0), m_centerZ(0), m_epoch(0),
+    : m_level(level), m_running(false), m_frontierCursor(0), m_frontierRadius(-1),
+      m_nextBuildSequence(0), m_active(0), m_maxActive(0), m_finished(FINISHED_CAPACITY),
+      m_lastPlayerChunk{INT32_MAX, INT32_MAX, INT32_MAX}, m_centerX(0), m_centerZ(0),
       m_renderDistance(0)
 {}
 
@@ -35,16 +39,62 @@ void ChunkManager::start()
     }
     m_running.store(true);
 
-    int threadCount = std::max(1u, std::thread::hardware_concurrency() - 2);
+    int threadCount = (int) JobSystem::get()->getConcurrencyCap(JobClass::GENERATION);
     Logger::logInfo("Starting chunk generation with %d threads", threadCount);
 
-    m_pool      = std::make_unique<ThreadPool>((size_t) threadCount);
     m_maxActive = std::max(1, threadCount * 4);
 
     if (m_level)
     {
         m_renderDistance.store(m_level->getRenderDistance());
     }
+
+    createGenerators();
+    warmUp();
+}
+
+void ChunkManager::createGenerators()
+{
+    uint32_t seed = m_level ? m_level->getSeed() : 0;
+
+    m_generators.clear();
+    m_generators.reserve(JobSystem::get()->getThreadCount());
+    for (size_t i = 0; i < JobSystem::get()->getThreadCount(); i++)
+    {
+        m_generators.push_back(std::make_unique<TerrainGenerator>(seed));
+    }
+    m_mainGenerator = std::make_unique<TerrainGenerator>(seed);
+}
+
+void ChunkManager::warmUp()
+{
+    if (JobSystem::get()->getWorkerIndex() >= 0)
+    {
+        Logger::logWarn("Skipping chunk generator warm-up requested from a worker thread");
+        return;
+    }
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    JobSystem::get()->runOnEachWorker([this](size_t index) {
+        std::unique_ptr<Chunk> chunk = std::make_unique<Chunk>(ChunkPos(0, 0, 0));
+        m_generators[index]->generateChunk(*chunk, ChunkPos(0, 0, 0));
+    });
+
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+                        .count();
+    Logger::logInfo("Warmed up %d chunk generation workers in %.2f ms",
+                    (int) JobSystem::get()->getThreadCount(), ms);
+}
+
+TerrainGenerator &ChunkManager::getGenerator()
+{
+    int index = JobSystem::get()->getWorkerIndex();
+    if (index < 0 || (size_t) index >= m_generators.size())
+    {
+        return *m_mainGenerator;
+    }
+    return *m_generators[(size_t) index];
 }
 
 void ChunkManager::stop()
@@ -58,23 +108,33 @@ void ChunkManager::stop()
     {
         std::lock_guard<std::mutex> lock(m_pendingMutex);
 
-        while (!m_pending.empty())
+        m_frontierCursor = 0;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_activeMutex);
+
+        for (const auto &[pos, task] : m_activeTasks)
         {
-            m_pending.pop();
+            task.token.cancel();
         }
-        m_pendingSet.clear();
     }
 
-    if (m_pool)
+    releaseUncommitted();
+    while (m_active.load() > 0)
     {
-        m_pool->wait();
-        m_pool.reset();
+        JobSystem::get()->waitForClass(JobClass::IO);
+        JobSystem::get()->waitForClass(JobClass::GENERATION);
+        JobSystem::get()->waitForClass(JobClass::LIGHTING);
+        std::this_thread::yield();
     }
+    m_generators.clear();
+    m_mainGenerator.reset();
 
     {
         std::lock_guard<std::mutex> lock(m_activeMutex);
 
-        m_activeSet.clear();
+        m_activeTasks.clear();
     }
 
     m_active.store(0);
@@ -82,28 +142,27 @@ void ChunkManager::stop()
     Logger::logInfo("Chunk generation stopped");
 }
 
-bool ChunkManager::shouldStartTask(const ChunkPos &pos, uint32_t taskEpoch) const
+Level *ChunkManager::getLevel() const { return m_level; }
+
+void ChunkManager::setLevel(Level *level)
 {
-    if (!m_running.load())
-    {
-        return false;
-    }
-    if (taskEpoch != m_epoch.load())
-    {
-        return false;
-    }
+    bool wasRunning = m_running.load();
+    stop();
 
-    ChunkPos center{m_centerX.load(), 0, m_centerZ.load()};
-    if (!isChunkInRenderDistance(pos, center))
+    m_finished.clear();
+
+    m_level           = level;
+    m_lastPlayerChunk = ChunkPos{INT32_MAX, INT32_MAX, INT32_MAX};
+
+    if (wasRunning)
     {
-        return false;
+        start();
     }
-    return true;
 }
 
-bool ChunkManager::shouldKeepResult(const ChunkPos &pos) const
+bool ChunkManager::shouldKeepResult(const ChunkPos &pos, const CancellationToken &token) const
 {
-    if (!m_running.load())
+    if (!m_running.load() || token.isCancelled())
     {
         return false;
     }
@@ -116,245 +175,328 @@ bool ChunkManager::shouldKeepResult(const ChunkPos &pos) const
     return true;
 }
 
-void ChunkManager::rebuildPending(const ChunkPos &center,
-                                  const std::unordered_set<ChunkPos, ChunkPosHash> &known)
+void ChunkManager::rebuildFrontier(int renderDistance)
 {
-    uint32_t epoch     = m_epoch.load();
-    int renderDistance = m_renderDistance.load();
-    int maxD2          = renderDistance * renderDistance;
+    int maxD2 = renderDistance * renderDistance;
 
-    std::vector<GenerationTask> tasks;
-    tasks.reserve((size_t) ((renderDistance * 2 + 1) * (renderDistance * 2 + 1)));
+    m_frontier.clear();
+    m_frontier.reserve((size_t) ((renderDistance * 2 + 1) * (renderDistance * 2 + 1)));
 
     for (int dz = -renderDistance; dz <= renderDistance; dz++)
         for (int dx = -renderDistance; dx <= renderDistance; dx++)
         {
             int d2 = dx * dx + dz * dz;
-            if (d2 > maxD2)
-            {
-                continue;
-            }
-
-            ChunkPos pos{center.x + dx, 0, center.z + dz};
-            if (known.count(pos))
+            if (d2 <= maxD2)
             {
-                continue;
+                m_frontier.push_back({dx, dz, d2});
             }
-            {
-                std::lock_guard<std::mutex> lock(m_activeMutex);
-
-                if (m_activeSet.find(pos) != m_activeSet.end())
-                {
-                    continue;
-                }
-            }
-
-            tasks.push_back({pos, d2, epoch});
         }
 
-    std::sort(tasks.begin(), tasks.end(), [](const GenerationTask &a, const GenerationTask &b) {
-        if (a.dist2 != b.dist2)
-        {
-            return a.dist2 < b.dist2;
-        }
-        if (a.pos.x != b.pos.x)
-        {
-            return a.pos.x < b.pos.x;
-        }
-        return a.pos.z < b.pos.z;
-    });
+    std::sort(m_frontier.begin(), m_frontier.end(),
+              [](const FrontierOffset &a, const FrontierOffset &b) {
+                  if (a.dist2 != b.dist2)
+                  {
+                      return a.dist2 < b.dist2;
+                  }
+                  if (a.dx != b.dx)
+                  {
+                      return a.dx < b.dx;
+                  }
+                  return a.dz < b.dz;
+              });
+
+    m_frontierRadius = renderDistance;
+    m_frontierCursor = 0;
+}
 
+void ChunkManager::moveFrontier(const ChunkPos &from, const ChunkPos &to)
+{
     std::lock_guard<std::mutex> lock(m_pendingMutex);
-    while (!m_pending.empty()) m_pending.pop();
-    m_pendingSet.clear();
 
-    for (const GenerationTask &task : tasks)
+    if (m_frontierCursor == 0 || from.x == INT32_MAX)
     {
-        if (m_pendingSet.insert(task.pos).second)
-        {
-            m_pending.push(task);
-        }
+        m_frontierCursor = 0;
+        return;
     }
+
+    int reached = m_frontierCursor < m_frontier.size()
+                          ? m_frontier[m_frontierCursor].dist2
+                          : m_frontierRadius * m_frontierRadius + 1;
+
+    double dx     = (double) to.x - from.x;
+    double dz     = (double) to.z - from.z;
+    double radius = std::sqrt((double) reached) - std::sqrt(dx * dx + dz * dz);
+    if (radius <= 0.0)
+    {
+        m_frontierCursor = 0;
+        return;
+    }
+
+    int covered      = (int) std::floor(radius * radius);
+    m_frontierCursor = (size_t) (std::lower_bound(m_frontier.begin(), m_frontier.end(), covered,
+                                                  [](const FrontierOffset &offset, int dist2) {
+                                                      return offset.dist2 < dist2;
+                                                  }) -
+                                 m_frontier.begin());
 }
 
-void ChunkManager::update(const Vec3 &playerPosition)
+void ChunkManager::update(const Vec3 &playerPosition, const Vec3 &playerVelocity,
+                          const Vec3 &viewDirection)
 {
-    int cx = Mth::floorDiv((int) playerPosition.x, Chunk::SIZE_X);
-    int cz = Mth::floorDiv((int) playerPosition.z, Chunk::SIZE_Z);
-    ChunkPos playerChunk{cx, 0, cz};
-
     if (m_level)
     {
         m_renderDistance.store(m_level->getRenderDistance());
     }
 
-    if (!m_pool || !m_running.load())
+    ChunkPriority priority(playerPosition, playerVelocity, viewDirection, m_renderDistance.load());
+    const ChunkPos &playerChunk = priority.getChunk();
+
+    if (!m_running.load())
     {
         m_lastPlayerChunk = playerChunk;
         return;
     }
 
+    {
+        std::lock_guard<std::mutex> lock(m_pendingMutex);
+
+        if (m_frontierRadius != m_renderDistance.load())
+        {
+            rebuildFrontier(m_renderDistance.load());
+        }
+    }
+
+    bool retarget;
+    {
+        std::lock_guard<std::mutex> lock(m_priorityMutex);
+
+        retarget   = !priority.isEquivalent(m_priority);
+        m_priority = priority;
+    }
+
     if (playerChunk != m_lastPlayerChunk)
     {
+        moveFrontier(m_lastPlayerChunk, playerChunk);
         m_lastPlayerChunk = playerChunk;
 
         m_centerX.store(playerChunk.x);
         m_centerZ.store(playerChunk.z);
-        m_epoch.fetch_add(1);
-
-        std::unordered_set<ChunkPos, ChunkPosHash> known;
-        const std::unordered_map<ChunkPos, std::unique_ptr<Chunk>, ChunkPosHash> &chunks =
-                m_level->getChunks();
-        known.reserve(chunks.size());
-        for (const auto &[pos, _] : chunks)
-        {
-            known.insert(pos);
-        }
+        retarget = true;
+    }
 
-        rebuildPending(playerChunk, known);
+    if (retarget)
+    {
+        retargetActive(playerChunk);
     }
 
     dispatchPending();
 }
 
-void ChunkManager::dispatchPending()
+void ChunkManager::retargetActive(const ChunkPos &center)
 {
-    if (!m_pool)
+    std::lock_guard<std::mutex> lock(m_activeMutex);
+
+    for (const auto &[pos, task] : m_activeTasks)
     {
-        return;
+        if (!isChunkInRenderDistance(pos, center))
+        {
+            task.token.cancel();
+            continue;
+        }
+        task.ticket->setPriority(calculatePriority(pos));
     }
+}
+
+void ChunkManager::dispatchPending()
+{
     if (!m_running.load())
     {
         return;
     }
 
+    ChunkPos center{m_centerX.load(), 0, m_centerZ.load()};
+
     int startBudget = 8;
-    while (startBudget-- > 0 && m_active.load() < m_maxActive)
+    while (startBudget > 0 && m_active.load() < m_maxActive &&
+           m_finished.size() + (size_t) m_active.load() < m_finished.capacity())
     {
-        GenerationTask task;
+        ChunkPos pos;
 
         {
             std::lock_guard<std::mutex> lock(m_pendingMutex);
 
-            if (m_pending.empty())
+            if (m_frontierCursor >= m_frontier.size())
             {
                 break;
             }
 
-            task = m_pending.top();
-            m_pending.pop();
-            m_pendingSet.erase(task.pos);
+            const FrontierOffset &offset = m_frontier[m_frontierCursor++];
+            pos                          = ChunkPos(center.x + offset.dx, 0, center.z + offset.dz);
         }
 
-        if (!shouldStartTask(task.pos, task.epoch))
+        if (m_level->hasChunk(pos))
         {
             continue;
         }
 
+        std::shared_ptr<ChunkBuild> build = std::make_shared<ChunkBuild>();
+        build->pos                        = pos;
+        build->token                      = CancellationToken::create();
+        build->ticket    = std::make_shared<JobTicket>(calculatePriority(pos));
+        build->committed = std::make_shared<JobEvent>();
+        build->adopted   = false;
+
         {
             std::lock_guard<std::mutex> lock(m_activeMutex);
 
-            if (m_activeSet.find(task.pos) != m_activeSet.end())
+            if (m_activeTasks.find(pos) != m_activeTasks.end())
             {
                 continue;
             }
-            m_activeSet.insert(task.pos);
-        }
 
-        m_active.fetch_add(1);
+            m_active.fetch_add(1);
 
-        m_pool->detachTask([this, pos = task.pos, epoch = task.epoch] {
-            ThreadStorage::useDefaultThreadStorage();
-            if (shouldStartTask(pos, epoch))
-            {
-                generateChunk(pos);
-            }
-
-            {
-                std::lock_guard<std::mutex> lock(m_activeMutex);
-
-                m_activeSet.erase(pos);
-            }
+            build->sequence    = m_nextBuildSequence++;
+            build->tracked     = m_uncommitted.try_emplace(pos, build).second;
+            m_activeTasks[pos] = {build->ticket, build->token};
+        }
 
-            m_active.fetch_sub(1);
-        });
+        buildChunk(std::move(build));
+        startBudget--;
     }
 }
 
 void ChunkManager::drainFinished(std::deque<std::pair<ChunkPos, std::unique_ptr<Chunk>>> *out,
                                  int max)
 {
-    std::lock_guard<std::mutex> lock(m_finishedMutex);
-
-    int count = 0;
-    while (!m_finished.empty() && count < max)
-    {
-        out->emplace_back(std::move(m_finished.front()));
-        m_finished.pop_front();
-        count++;
-    }
+    m_finished.drain(out, (size_t) max);
 }
 
 size_t ChunkManager::getPendingCount() const
 {
     std::lock_guard<std::mutex> lock(m_pendingMutex);
-    return m_pending.size();
+    return m_frontier.size() - std::min(m_frontierCursor, m_frontier.size());
 }
 
 size_t ChunkManager::getActiveCount() const { return (size_t) m_active.load(); }
 
 size_t ChunkManager::getMaxActiveCount() const { return (size_t) m_maxActive; }
 
-size_t ChunkManager::getFinishedCount() const
-{
-    std::lock_guard<std::mutex> lock(m_finishedMutex);
-    return m_finished.size();
-}
+size_t ChunkManager::getFinishedCount() const { return m_finished.size(); }
 
 size_t ChunkManager::getThreadCount() const
 {
-    if (!m_pool)
+    if (!m_running.load())
     {
         return 0;
     }
-    return m_pool->getThreadCount();
+    return JobSystem::get()->getConcurrencyCap(JobClass::GENERATION);
 }
 
-void ChunkManager::generateChunk(const ChunkPos &pos)
+JobCoroutine ChunkManager::buildChunk(std::shared_ptr<ChunkBuild> build)
 {
-    thread_local TerrainGenerator generator(0);
-
-    std::unique_ptr<Chunk> chunk = std::make_unique<Chunk>(pos);
+    ChunkStorage *storage = m_level ? m_level->getChunkStorage() : nullptr;
+    if (storage && storage->shouldLoad(build->pos))
+    {
+        co_await ResumeOn(JobClass::IO, build->ticket, build->token);
+        if (!build->token.isCancelled())
+        {
+            build->chunk = storage->load(build->pos);
+        }
+    }
 
-    if (m_level && m_level->isWorldBorderEnabled() && !m_level->isChunkInsideWorldBorder(pos))
+    if (!build->chunk && !build->token.isCancelled())
     {
-        Block *borderBlock = Block::byName("world_border");
-        for (int z = 0; z < Chunk::SIZE_Z; z++)
+        co_await ResumeOn(JobClass::GENERATION, build->ticket, build->token);
+        if (!build->token.isCancelled())
         {
-            for (int y = 0; y < Chunk::SIZE_Y; y++)
-            {
-                for (int x = 0; x < Chunk::SIZE_X; x++)
-                {
-                    chunk->setBlock(x, y, z, borderBlock);
-                    chunk->setSkyLight(x, y, z, 0);
-                }
-            }
+            generateChunk(build.get());
         }
+    }
 
-        if (!shouldKeepResult(pos))
+    if (build->chunk && !build->token.isCancelled())
+    {
+        for (const std::shared_ptr<JobEvent> &neighbor : getEarlierNeighbors(*build))
         {
-            return;
+            co_await *neighbor;
         }
 
+        co_await ResumeOn(JobClass::LIGHTING, build->ticket, build->token);
+        if (!build->token.isCancelled())
         {
-            std::lock_guard<std::mutex> lock(m_finishedMutex);
+            stitchLight(build.get());
+        }
+    }
+
+    // Await the commit before publishing, so meshing resumes inside the main thread's commit.
+    if (build->tracked)
+    {
+        meshWhenCommitted(build);
+    }
+    finishBuild(build.get());
+}
+
+JobCoroutine ChunkManager::meshWhenCommitted(std::shared_ptr<ChunkBuild> build)
+{
+    co_await *build->committed;
+    if (!build->adopted)
+    {
+        co_return;
+    }
 
-            m_finished.emplace_back(pos, std::move(chunk));
+    static const int NEIGHBORS[4][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
+
+    LevelRenderer *levelRenderer = Minecraft::getInstance()->getLevelRenderer();
+    Dimension *dimension         = m_level->getDimension();
+
+    const ChunkPos &pos = build->pos;
+    if (levelRenderer)
+    {
+        levelRenderer->rebuildCommittedChunk(pos);
+    }
+    else
+    {
+        dimension->markChunkDirty(pos);
+    }
+
+    for (const int *offset : NEIGHBORS)
+    {
+        ChunkPos neighborPos(pos.x + offset[0], pos.y, pos.z + offset[1]);
+        if (levelRenderer)
+        {
+            levelRenderer->rebuildCommittedChunk(neighborPos);
         }
+        else
+        {
+            dimension->markChunkDirty(neighborPos);
+        }
+    }
+}
+
+void ChunkManager::generateChunk(ChunkBuild *build)
+{
+    const ChunkPos &pos         = build->pos;
+    TerrainGenerator &generator = getGenerator();
+
+    ChunkStorage *storage = m_level ? m_level->getChunkStorage() : nullptr;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    std::unique_ptr<Chunk> chunk = std::make_unique<Chunk>(pos);
+
+    if (m_level && m_level->isWorldBorderEnabled() && !m_level->isChunkInsideWorldBorder(pos))
+    {
+        chunk->fill(Blocks::WORLD_BORDER.getId());
+        chunk->setUnmodified(true);
+        build->chunk = std::move(chunk);
         return;
     }
 
     generator.generateChunk(*chunk, pos);
+    if (build->token.isCancelled())
+    {
+        return;
+    }
 
     for (int z = 0; z < Chunk::SIZE_Z; z++)
     {
@@ -370,7 +512,7 @@ void ChunkManager::generateChunk(const ChunkPos &pos)
                         continue;
                     }
 
-                    if (Block::byId(chunk->getBlockId(x, y, z))->isSolid())
+                    if (BlockProperties::isSolid(chunk->getBlockId(x, y, z)))
                     {
                         blocked = true;
                         chunk->setSkyLight(x, y, z, 0);
@@ -400,109 +542,234 @@ void ChunkManager::generateChunk(const ChunkPos &pos)
         }
     }
 
-    static const int DIRECTIONS[6][3] = {{1, 0, 0},  {-1, 0, 0}, {0, 1, 0},
-                                         {0, -1, 0}, {0, 0, 1},  {0, 0, -1}};
+    if (!propagateSkyLight(*chunk, &lightQueue, build->token))
+    {
+        return;
+    }
 
-    while (!lightQueue.empty())
+    if (storage)
     {
-        LightEngine::SkyLightNode node = lightQueue.front();
-        lightQueue.pop();
+        storage->recordGenerateTime(
+                std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
 
-        uint8_t currentLevel = chunk->getSkyLight(node.x, node.y, node.z);
-        if (currentLevel == 0)
+    build->chunk = std::move(chunk);
+}
+
+void ChunkManager::stitchLight(ChunkBuild *build)
+{
+    if (!m_level)
+    {
+        return;
+    }
+
+    static const int NEIGHBORS[4][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
+
+    Chunk &chunk = *build->chunk;
+    std::queue<LightEngine::SkyLightNode> lightQueue;
+    std::vector<uint8_t> border;
+
+    for (const int *offset : NEIGHBORS)
+    {
+        int span = offset[0] != 0 ? Chunk::SIZE_Z : Chunk::SIZE_X;
+        border.assign((size_t) span * Chunk::SIZE_Y, 0);
+
+        ChunkPos neighborPos(build->pos.x + offset[0], build->pos.y, build->pos.z + offset[1]);
+        bool hasNeighbor = m_level->readChunk(neighborPos, [&](const Chunk &neighbor) {
+            for (int y = 0; y < Chunk::SIZE_Y; y++)
+            {
+                for (int i = 0; i < span; i++)
+                {
+                    int x = offset[0] < 0 ? Chunk::SIZE_X - 1 : (offset[0] > 0 ? 0 : i);
+                    int z = offset[1] < 0 ? Chunk::SIZE_Z - 1 : (offset[1] > 0 ? 0 : i);
+                    border[(size_t) y * span + i] = neighbor.getSkyLight(x, y, z);
+                }
+            }
+        });
+        if (!hasNeighbor)
         {
             continue;
         }
 
-        for (int i = 0; i < 6; i++)
+        for (int y = 0; y < Chunk::SIZE_Y; y++)
         {
-            int nx = node.x + DIRECTIONS[i][0];
-            int ny = node.y + DIRECTIONS[i][1];
-            int nz = node.z + DIRECTIONS[i][2];
-            if (nx < 0 || nx >= Chunk::SIZE_X || ny < 0 || ny >= Chunk::SIZE_Y || nz < 0 ||
-                nz >= Chunk::SIZE_Z)
+            for (int i = 0; i < span; i++)
             {
-                continue;
-            }
-
-            if (Block::byId(chunk->getBlockId(nx, ny, nz))->isSolid())
-            {
-                continue;
-            }
+                uint8_t incoming = border[(size_t) y * span + i];
+                if (incoming <= 1)
+                {
+                    continue;
+                }
 
-            uint8_t neighborLevel = chunk->getSkyLight(nx, ny, nz);
+                int x = offset[0] < 0 ? 0 : (offset[0] > 0 ? Chunk::SIZE_X - 1 : i);
+                int z = offset[1] < 0 ? 0 : (offset[1] > 0 ? Chunk::SIZE_Z - 1 : i);
 
-            uint8_t newLevel;
-            if (DIRECTIONS[i][1] == -1 && currentLevel == 15)
-            {
-                newLevel = 15;
-            }
-            else
-            {
-                newLevel = currentLevel > 1 ? currentLevel - 1 : 0;
-            }
+                uint8_t level = incoming - 1;
+                if (level <= chunk.getSkyLight(x, y, z) ||
+                    BlockProperties::isSolid(chunk.getBlockId(x, y, z)))
+                {
+                    continue;
+                }
 
-            if (newLevel > neighborLevel)
-            {
-                chunk->setSkyLight(nx, ny, nz, newLevel);
-                lightQueue.push({nx, ny, nz, newLevel});
+                chunk.setSkyLight(x, y, z, level);
+                lightQueue.push({x, y, z, level});
             }
         }
     }
 
-    if (!shouldKeepResult(pos))
+    propagateSkyLight(chunk, &lightQueue, build->token);
+}
+
+void ChunkManager::finishBuild(ChunkBuild *build)
+{
+    bool keep = build->chunk && shouldKeepResult(build->pos, build->token);
+    if (keep)
     {
-        return;
+        m_finished.push({build->pos, std::move(build->chunk)});
     }
 
     {
-        std::lock_guard<std::mutex> lock(m_finishedMutex);
+        std::lock_guard<std::mutex> lock(m_activeMutex);
+
+        m_activeTasks.erase(build->pos);
 
-        m_finished.emplace_back(pos, std::move(chunk));
+        auto it = m_uncommitted.find(build->pos);
+        if (!keep && it != m_uncommitted.end() && it->second.get() == build)
+        {
+            m_uncommitted.erase(it);
+        }
+    }
+
+    if (!keep)
+    {
+        build->committed->set();
     }
+
+    m_active.fetch_sub(1);
 }
 
-void ChunkManager::queueChunkGeneration(const ChunkPos &pos)
+void ChunkManager::notifyCommitted(const ChunkPos &pos, bool adopted)
 {
-    if (!m_pool)
+    std::shared_ptr<ChunkBuild> build;
+
     {
-        return;
+        std::lock_guard<std::mutex> lock(m_activeMutex);
+
+        auto it = m_uncommitted.find(pos);
+        if (it == m_uncommitted.end())
+        {
+            return;
+        }
+        build = std::move(it->second);
+        m_uncommitted.erase(it);
     }
-    if (!m_running.load())
+
+    build->adopted = adopted;
+    build->committed->set();
+}
+
+std::vector<std::shared_ptr<JobEvent>> ChunkManager::getEarlierNeighbors(const ChunkBuild &build)
+{
+    static const int NEIGHBORS[4][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
+
+    std::vector<std::shared_ptr<JobEvent>> neighbors;
+
+    std::lock_guard<std::mutex> lock(m_activeMutex);
+
+    for (const int *offset : NEIGHBORS)
     {
-        return;
+        ChunkPos neighborPos(build.pos.x + offset[0], build.pos.y, build.pos.z + offset[1]);
+        auto it = m_uncommitted.find(neighborPos);
+        if (it != m_uncommitted.end() && it->second->sequence < build.sequence)
+        {
+            neighbors.push_back(it->second->committed);
+        }
     }
+    return neighbors;
+}
 
-    ChunkPos center{m_centerX.load(), 0, m_centerZ.load()};
-    if (!isChunkInRenderDistance(pos, center))
-        return;
+void ChunkManager::releaseUncommitted()
+{
+    std::vector<std::shared_ptr<JobEvent>> events;
 
     {
         std::lock_guard<std::mutex> lock(m_activeMutex);
 
-        if (m_activeSet.find(pos) != m_activeSet.end())
+        events.reserve(m_uncommitted.size());
+        for (const auto &[pos, build] : m_uncommitted)
         {
-            return;
+            events.push_back(build->committed);
         }
+        m_uncommitted.clear();
     }
 
+    for (const std::shared_ptr<JobEvent> &event : events)
     {
-        std::lock_guard<std::mutex> lock(m_pendingMutex);
+        event->set();
+    }
+}
+
+bool ChunkManager::propagateSkyLight(Chunk &chunk,
+                                     std::queue<LightEngine::SkyLightNode> *lightQueue,
+                                     const CancellationToken &token)
+{
+    static const int DIRECTIONS[6][3] = {{1, 0, 0},  {-1, 0, 0}, {0, 1, 0},
+                                         {0, -1, 0}, {0, 0, 1},  {0, 0, -1}};
+
+    size_t visited = 0;
+    while (!lightQueue->empty())
+    {
+        if ((++visited & CANCEL_POLL_MASK) == 0 && token.isCancelled())
+        {
+            return false;
+        }
 
-        if (m_pendingSet.find(pos) != m_pendingSet.end())
+        LightEngine::SkyLightNode node = lightQueue->front();
+        lightQueue->pop();
+
+        uint8_t currentLevel = chunk.getSkyLight(node.x, node.y, node.z);
+        if (currentLevel == 0)
         {
-            return;
+            continue;
         }
-        m_pendingSet.insert(pos);
 
-        int dx = pos.x - center.x;
-        int dz = pos.z - center.z;
-        int d2 = dx * dx + dz * dz;
+        for (int i = 0; i < 6; i++)
+        {
+            int nx = node.x + DIRECTIONS[i][0];
+            int ny = node.y + DIRECTIONS[i][1];
+            int nz = node.z + DIRECTIONS[i][2];
+            if (nx < 0 || nx >= Chunk::SIZE_X || ny < 0 || ny >= Chunk::SIZE_Y || nz < 0 ||
+                nz >= Chunk::SIZE_Z)
+            {
+                continue;
+            }
+
+            if (BlockProperties::isSolid(chunk.getBlockId(nx, ny, nz)))
+            {
+                continue;
+            }
+
+            uint8_t neighborLevel = chunk.getSkyLight(nx, ny, nz);
 
-        m_pending.push({pos, d2, m_epoch.load()});
+            uint8_t newLevel;
+            if (DIRECTIONS[i][1] == -1 && currentLevel == 15)
+            {
+                newLevel = 15;
+            }
+            else
+            {
+                newLevel = currentLevel > 1 ? currentLevel - 1 : 0;
+            }
+
+            if (newLevel > neighborLevel)
+            {
+                chunk.setSkyLight(nx, ny, nz, newLevel);
+                lightQueue->push({nx, ny, nz, newLevel});
+            }
+        }
     }
 
-    dispatchPending();
+    return true;
 }
 
 bool ChunkManager::isChunkInRenderDistance(const ChunkPos &pos, const ChunkPos &center) const
@@ -513,9 +780,8 @@ bool ChunkManager::isChunkInRenderDistance(const ChunkPos &pos, const ChunkPos &
     return (dx * dx + dz * dz) <= (renderDistance * renderDistance);
 }
 
-int ChunkManager::calculatePriority(const ChunkPos &pos, const ChunkPos &center) const
+int ChunkManager::calculatePriority(const ChunkPos &pos) const
 {
-    int dx = pos.x - center.x;
-    int dz = pos.z - center.z;
-    return -(dx * dx + dz * dz);
+    std::lock_guard<std::mutex> lock(m_priorityMutex);
+    return m_priority.score(pos);
 }
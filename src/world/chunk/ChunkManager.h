@@ -1,16 +1,22 @@
 #pragma once
 
 #include <atomic>
+#include <cstdint>
 #include <deque>
 #include <memory>
 #include <mutex>
-#include <unordered_set>
+#include <queue>
+#include <unordered_map>
 #include <vector>
 
-#include "../../threading/ThreadPool.h"
-#include "../../utils/heap/BinaryHeap.h"
+#include "../../threading/CancellationToken.h"
+#include "../../threading/JobCoroutine.h"
+#include "../../threading/MpscQueue.h"
 #include "../Level.h"
+#include "../generation/TerrainGenerator.h"
+#include "../lighting/LightEngine.h"
 #include "ChunkPos.h"
+#include "ChunkPriority.h"
 
 class ChunkManager
 {
@@ -20,9 +26,12 @@ public:
 
     void start();
     void stop();
-    void update(const Vec3 &playerPosition);
+    Level *getLevel() const;
+    void setLevel(Level *level);
+    void update(const Vec3 &playerPosition, const Vec3 &playerVelocity, const Vec3 &viewDirection);
 
     void drainFinished(std::deque<std::pair<ChunkPos, std::unique_ptr<Chunk>>> *out, int max);
+    void notifyCommitted(const ChunkPos &pos, bool adopted);
     size_t getPendingCount() const;
     size_t getActiveCount() const;
     size_t getMaxActiveCount() const;
@@ -30,60 +39,86 @@ public:
     size_t getThreadCount() const;
 
 private:
-    struct GenerationTask
+    static constexpr size_t CANCEL_POLL_MASK  = 4095;
+    static constexpr size_t FINISHED_CAPACITY = 1024;
+
+    struct FrontierOffset
     {
-        ChunkPos pos;
+        int dx;
+        int dz;
         int dist2;
-        uint32_t epoch;
     };
 
-    struct TaskCompare
+    struct ActiveTask
     {
-        bool operator()(const GenerationTask &a, const GenerationTask &b) const
-        {
-            if (a.dist2 != b.dist2)
-                return a.dist2 > b.dist2;
-            if (a.pos.x != b.pos.x)
-                return a.pos.x > b.pos.x;
-            return a.pos.z > b.pos.z;
-        }
+        std::shared_ptr<JobTicket> ticket;
+        CancellationToken token;
     };
 
-    void generateChunk(const ChunkPos &pos);
-    void queueChunkGeneration(const ChunkPos &pos);
+    struct ChunkBuild
+    {
+        ChunkPos pos;
+        std::unique_ptr<Chunk> chunk;
+        CancellationToken token;
+        std::shared_ptr<JobTicket> ticket;
+        std::shared_ptr<JobEvent> committed;
+        uint64_t sequence;
+        bool tracked;
+        bool adopted;
+    };
+
+    void createGenerators();
+    // Blocks until every worker has generated a column, so it only runs on the main thread.
+    void warmUp();
+    TerrainGenerator &getGenerator();
+
+    JobCoroutine buildChunk(std::shared_ptr<ChunkBuild> build);
+    void generateChunk(ChunkBuild *build);
+    void stitchLight(ChunkBuild *build);
+    void finishBuild(ChunkBuild *build);
+    JobCoroutine meshWhenCommitted(std::shared_ptr<ChunkBuild> build);
+    std::vector<std::shared_ptr<JobEvent>> getEarlierNeighbors(const ChunkBuild &build);
+    void releaseUncommitted();
+    static bool propagateSkyLight(Chunk &chunk, std::queue<LightEngine::SkyLightNode> *lightQueue,
+                                  const CancellationToken &token);
     bool isChunkInRenderDistance(const ChunkPos &pos, const ChunkPos &center) const;
-    int calculatePriority(const ChunkPos &pos, const ChunkPos &center) const;
+    int calculatePriority(const ChunkPos &pos) const;
 
-    void rebuildPending(const ChunkPos &center,
-                        const std::unordered_set<ChunkPos, ChunkPosHash> &known);
+    void rebuildFrontier(int renderDistance);
+    void moveFrontier(const ChunkPos &from, const ChunkPos &to);
+    void retargetActive(const ChunkPos &center);
     void dispatchPending();
 
-    bool shouldStartTask(const ChunkPos &pos, uint32_t taskEpoch) const;
-    bool shouldKeepResult(const ChunkPos &pos) const;
+    bool shouldKeepResult(const ChunkPos &pos, const CancellationToken &token) const;
 
     Level *m_level;
 
-    std::unique_ptr<ThreadPool> m_pool;
+    std::vector<std::unique_ptr<TerrainGenerator>> m_generators;
+    std::unique_ptr<TerrainGenerator> m_mainGenerator;
     std::atomic<bool> m_running;
 
-    BinaryHeap<GenerationTask, TaskCompare> m_pending;
-    std::unordered_set<ChunkPos, ChunkPosHash> m_pendingSet;
+    std::vector<FrontierOffset> m_frontier;
+    size_t m_frontierCursor;
+    int m_frontierRadius;
     mutable std::mutex m_pendingMutex;
 
-    std::unordered_set<ChunkPos, ChunkPosHash> m_activeSet;
+    std::unordered_map<ChunkPos, ActiveTask, ChunkPosHash> m_activeTasks;
+    std::unordered_map<ChunkPos, std::shared_ptr<ChunkBuild>, ChunkPosHash> m_uncommitted;
+    uint64_t m_nextBuildSequence;
     std::mutex m_activeMutex;
 
     std::atomic<int> m_active;
     int m_maxActive;
 
-    std::deque<std::pair<ChunkPos, std::unique_ptr<Chunk>>> m_finished;
-    mutable std::mutex m_finishedMutex;
+    MpscQueue<std::pair<ChunkPos, std::unique_ptr<Chunk>>> m_finished;
 
     ChunkPos m_lastPlayerChunk;
 
+    ChunkPriority m_priority;
+    mutable std::mutex m_priorityMutex;
+
     std::atomic<int> m_centerX;
     std::atomic<int> m_centerZ;
-    std::atomic<uint32_t> m_epoch;
 
     std::atomic<int> m_renderDistance;
 };
@@ -10,6 +10,8 @@
 #include "../../utils/math/Mth.h"
 #include "../LevelSource.h"
 #include "../block/Block.h"
+#include "../block/BlockProperties.h"
+#include "../block/Blocks.h"
 #include "../lighting/LightEngine.h"
 
 struct MaskCell
@@ -955,8 +957,7 @@ static void buildSolidCache(BuildData *buildData)
                     solid = 1;
                     if (chunk)
                     {
-                        Block *block = Block::byId(chunk->getBlockId(lx, y, lz));
-                        solid        = block ? (block->isSolid() ? 1 : 0) : 1;
+                        solid = BlockProperties::isSolid(chunk->getBlockId(lx, y, lz)) ? 1 : 0;
                     }
                 }
 
@@ -1346,8 +1347,9 @@ static void greedy2D(std::vector<MaskCell> &mask, int width, int height, bool us
         }
     }
 }
-void ChunkMesher::buildMeshes(Level *level, const Chunk *chunk, bool smoothLighting,
-                              bool grassSideOverlay, std::vector<MeshBuildResult> *outMeshes)
+bool ChunkMesher::buildMeshes(Level *level, const Chunk *chunk, bool smoothLighting,
+                              bool grassSideOverlay, std::vector<MeshBuildResult> *outMeshes,
+                              const CancellationToken &token)
 {
     std::unordered_map<Texture *, MeshBucket> buckets;
     BuildData buildData(level, chunk, smoothLighting);
@@ -1356,12 +1358,16 @@ void ChunkMesher::buildMeshes(Level *level, const Chunk *chunk, bool smoothLight
     {
         buildRawLightCache(&buildData);
     }
+    if (token.isCancelled())
+    {
+        return false;
+    }
 
     ChunkPos chunkPos = chunk->getPos();
     int baseX         = chunkPos.x * Chunk::SIZE_X;
     int baseY         = chunkPos.y * Chunk::SIZE_Y;
     int baseZ         = chunkPos.z * Chunk::SIZE_Z;
-    Block *grassBlock = Block::byName("grass");
+    Block *grassBlock = Blocks::GRASS.getBlock();
 
     EmitFace emit = [&](Direction *direction, Texture *texture, const Block::UVRect &atlasRect,
                         uint16_t rawLight, uint32_t tint, float x1, float y1, float z1, float x2,
@@ -1801,6 +1807,11 @@ void ChunkMesher::buildMeshes(Level *level, const Chunk *chunk, bool smoothLight
 
         for (int x = 0; x <= Chunk::SIZE_X; x++)
         {
+            if (token.isCancelled())
+            {
+                return false;
+            }
+
             for (int y = 0; y < Chunk::SIZE_Y; y++)
             {
                 for (int z = 0; z < Chunk::SIZE_Z; z++)
@@ -1816,13 +1827,14 @@ void ChunkMesher::buildMeshes(Level *level, const Chunk *chunk, bool smoothLight
 
                     if (a && !b && x > 0)
                     {
-                        Block *block     = Block::byId(chunk->getBlockId(x - 1, y, z));
-                        Texture *texture = block ? block->getTexture(Direction::EAST) : nullptr;
-                        if (texture)
+                        uint32_t id           = chunk->getBlockId(x - 1, y, z);
+                        const BlockFace &face = BlockProperties::getFace(id, Direction::EAST);
+                        if (face.texture)
                         {
+                            Block *block   = Block::byId(id);
                             cell.filled    = true;
-                            cell.texture   = texture;
-                            cell.atlasRect = block->getAtlasUVRect(Direction::EAST);
+                            cell.texture   = face.texture;
+                            cell.atlasRect = face.atlasRect;
                             cell.rawLight =
                                     sampleLightKey(buildData, baseX + x, baseY + y, baseZ + z);
                             cell.tint = block->resolveTint(Direction::EAST, level, chunk, x - 1, z);
@@ -1852,6 +1864,11 @@ void ChunkMesher::buildMeshes(Level *level, const Chunk *chunk, bool smoothLight
 
         for (int x = 0; x <= Chunk::SIZE_X; x++)
         {
+            if (token.isCancelled())
+            {
+                return false;
+            }
+
             for (int y = 0; y < Chunk::SIZE_Y; y++)
             {
                 for (int z = 0; z < Chunk::SIZE_Z; z++)
@@ -1868,13 +1885,14 @@ void ChunkMesher::buildMeshes(Level *level, const Chunk *chunk, bool smoothLight
 
                     if (b && !a && x < Chunk::SIZE_X)
                     {
-                        Block *block     = Block::byId(chunk->getBlockId(x, y, z));
-                        Texture *texture = block ? block->getTexture(Direction::WEST) : nullptr;
-                        if (texture)
+                        uint32_t id           = chunk->getBlockId(x, y, z);
+                        const BlockFace &face = BlockProperties::getFace(id, Direction::WEST);
+                        if (face.texture)
                         {
+                            Block *block   = Block::byId(id);
                             cell.filled    = true;
-                            cell.texture   = texture;
-                            cell.atlasRect = block->getAtlasUVRect(Direction::WEST);
+                            cell.texture   = face.texture;
+                            cell.atlasRect = face.atlasRect;
                             cell.rawLight =
                                     sampleLightKey(buildData, baseX + x - 1, baseY + y, baseZ + z);
                             cell.tint = block->resolveTint(Direction::WEST, level, chunk, x, z);
@@ -1909,6 +1927,11 @@ void ChunkMesher::buildMeshes(Level *level, const Chunk *chunk, bool smoothLight
 
         for (int z = 0; z <= Chunk::SIZE_Z; z++)
         {
+            if (token.isCancelled())
+            {
+                return false;
+            }
+
             for (int y = 0; y < Chunk::SIZE_Y; y++)
             {
                 for (int x = 0; x < Chunk::SIZE_X; x++)
@@ -1925,13 +1948,14 @@ void ChunkMesher::buildMeshes(Level *level, const Chunk *chunk, bool smoothLight
 
                     if (a && !b && z > 0)
                     {
-                        Block *block     = Block::byId(chunk->getBlockId(x, y, z - 1));
-                        Texture *texture = block ? block->getTexture(Direction::SOUTH) : nullptr;
-                        if (texture)
+                        uint32_t id           = chunk->getBlockId(x, y, z - 1);
+                        const BlockFace &face = BlockProperties::getFace(id, Direction::SOUTH);
+                        if (face.texture)
                         {
+                            Block *block   = Block::byId(id);
                             cell.filled    = true;
-                            cell.texture   = texture;
-                            cell.atlasRect = block->getAtlasUVRect(Direction::SOUTH);
+                            cell.texture   = face.texture;
+                            cell.atlasRect = face.atlasRect;
                             cell.rawLight =
                                     sampleLightKey(buildData, baseX + x, baseY + y, baseZ + z);
                             cell.tint =
@@ -1962,6 +1986,11 @@ void ChunkMesher::buildMeshes(Level *level, const Chunk *chunk, bool smoothLight
 
         for (int z = 0; z <= Chunk::SIZE_Z; z++)
         {
+            if (token.isCancelled())
+            {
+                return false;
+            }
+
             for (int y = 0; y < Chunk::SIZE_Y; y++)
             {
                 for (int x = 0; x < Chunk::SIZE_X; x++)
@@ -1978,13 +2007,14 @@ void ChunkMesher::buildMeshes(Level *level, const Chunk *chunk, bool smoothLight
 
                     if (b && !a && z < Chunk::SIZE_Z)
                     {
-                        Block *block     = Block::byId(chunk->getBlockId(x, y, z));
-                        Texture *texture = block ? block->getTexture(Direction::NORTH) : nullptr;
-                        if (texture)
+                        uint32_t id           = chunk->getBlockId(x, y, z);
+                        const BlockFace &face = BlockProperties::getFace(id, Direction::NORTH);
+                        if (face.texture)
                         {
+                            Block *block   = Block::byId(id);
                             cell.filled    = true;
-                            cell.texture   = texture;
-                            cell.atlasRect = block->getAtlasUVRect(Direction::NORTH);
+                            cell.texture   = face.texture;
+                            cell.atlasRect = face.atlasRect;
                             cell.rawLight =
                                     sampleLightKey(buildData, baseX + x, baseY + y, baseZ + z - 1);
                             cell.tint = block->resolveTint(Direction::NORTH, level, chunk, x, z);
@@ -2020,6 +2050,11 @@ void ChunkMesher::buildMeshes(Level *level, const Chunk *chunk, bool smoothLight
 
             for (int y = 0; y <= Chunk::SIZE_Y; y++)
             {
+                if (token.isCancelled())
+                {
+                    return false;
+                }
+
                 for (int z = 0; z < Chunk::SIZE_Z; z++)
                 {
                     for (int x = 0; x < Chunk::SIZE_X; x++)
@@ -2036,13 +2071,14 @@ void ChunkMesher::buildMeshes(Level *level, const Chunk *chunk, bool smoothLight
 
                         if (a && !b && y > 0)
                         {
-                            Block *block     = Block::byId(chunk->getBlockId(x, y - 1, z));
-                            Texture *texture = block ? block->getTexture(Direction::UP) : nullptr;
-                            if (texture)
+                            uint32_t id           = chunk->getBlockId(x, y - 1, z);
+                            const BlockFace &face = BlockProperties::getFace(id, Direction::UP);
+                            if (face.texture)
                             {
+                                Block *block   = Block::byId(id);
                                 cell.filled    = true;
-                                cell.texture   = texture;
-                                cell.atlasRect = block->getAtlasUVRect(Direction::UP);
+                                cell.texture   = face.texture;
+                                cell.atlasRect = face.atlasRect;
                                 cell.rawLight =
                                         sampleLightKey(buildData, baseX + x, baseY + y, baseZ + z);
                                 cell.tint = block->resolveTint(Direction::UP, level, chunk, x, z);
@@ -2082,13 +2118,14 @@ void ChunkMesher::buildMeshes(Level *level, const Chunk *chunk, bool smoothLight
 
                         if (b && !a && y < Chunk::SIZE_Y && y > 0)
                         {
-                            Block *block     = Block::byId(chunk->getBlockId(x, y, z));
-                            Texture *texture = block ? block->getTexture(Direction::DOWN) : nullptr;
-                            if (texture)
+                            uint32_t id           = chunk->getBlockId(x, y, z);
+                            const BlockFace &face = BlockProperties::getFace(id, Direction::DOWN);
+                            if (face.texture)
                             {
+                                Block *block   = Block::byId(id);
                                 cell.filled    = true;
-                                cell.texture   = texture;
-                                cell.atlasRect = block->getAtlasUVRect(Direction::DOWN);
+                                cell.texture   = face.texture;
+                                cell.atlasRect = face.atlasRect;
                                 cell.rawLight  = sampleLightKey(buildData, baseX + x, baseY + y - 1,
                                                                 baseZ + z);
                                 cell.tint = block->resolveTint(Direction::DOWN, level, chunk, x, z);
@@ -2113,19 +2150,25 @@ void ChunkMesher::buildMeshes(Level *level, const Chunk *chunk, bool smoothLight
 
         for (int x = 0; x < Chunk::SIZE_X; x++)
         {
+            if (token.isCancelled())
+            {
+                return false;
+            }
+
             for (int y = 0; y < Chunk::SIZE_Y; y++)
             {
                 for (int z = 0; z < Chunk::SIZE_Z; z++)
                 {
-                    Block *block = Block::byId(chunk->getBlockId(x, y, z));
-                    if (!block)
+                    uint32_t id                   = chunk->getBlockId(x, y, z);
+                    Block::RenderShape renderType = BlockProperties::getRenderShape(id);
+                    if (renderType != Block::RenderShape::CROSS &&
+                        renderType != Block::RenderShape::TORCH)
                     {
                         continue;
                     }
 
-                    Block::RenderShape renderType = block->getRenderShape();
-                    if (renderType != Block::RenderShape::CROSS &&
-                        renderType != Block::RenderShape::TORCH)
+                    Block *block = Block::byId(id);
+                    if (!block)
                     {
                         continue;
                     }
@@ -2407,4 +2450,6 @@ void ChunkMesher::buildMeshes(Level *level, const Chunk *chunk, bool smoothLight
             outMeshes->push_back(std::move(result));
         }
     }
+
+    return true;
 }
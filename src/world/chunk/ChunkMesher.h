@@ -3,6 +3,7 @@
 #include <vector>
 
 #include "../../rendering/Texture.h"
+#include "../../threading/CancellationToken.h"
 #include "../Level.h"
 #include "Chunk.h"
 
@@ -19,6 +20,7 @@ public:
         std::vector<uint32_t> tints;
     };
 
-    static void buildMeshes(Level *level, const Chunk *chunk, bool smoothLighting,
-                            bool grassSideOverlay, std::vector<MeshBuildResult> *outMeshes);
+    static bool buildMeshes(Level *level, const Chunk *chunk, bool smoothLighting,
+                            bool grassSideOverlay, std::vector<MeshBuildResult> *outMeshes,
+                            const CancellationToken &token = CancellationToken());
 };
@@ -0,0 +1,82 @@
+#include "ChunkPriority.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "../../utils/math/Mth.h"
+#include "Chunk.h"
+
+ChunkPriority::ChunkPriority()
+    : m_x(0.5), m_z(0.5), m_predictedX(0.5), m_predictedZ(0.5), m_frontX(0.0), m_frontZ(0.0),
+      m_hasFront(false), m_chunk(), m_predictedChunk()
+{}
+
+ChunkPriority::ChunkPriority(const Vec3 &position, const Vec3 &velocity, const Vec3 &front,
+                             int renderDistance)
+    : ChunkPriority()
+{
+    m_x = position.x / Chunk::SIZE_X;
+    m_z = position.z / Chunk::SIZE_Z;
+
+    double leadX   = velocity.x * LOOKAHEAD_SECONDS / Chunk::SIZE_X;
+    double leadZ   = velocity.z * LOOKAHEAD_SECONDS / Chunk::SIZE_Z;
+    double lead    = std::sqrt(leadX * leadX + leadZ * leadZ);
+    double maxLead = std::max(1.0, renderDistance * 0.5);
+    if (lead > maxLead)
+    {
+        leadX *= maxLead / lead;
+        leadZ *= maxLead / lead;
+    }
+    m_predictedX = m_x + leadX;
+    m_predictedZ = m_z + leadZ;
+
+    double frontLength = std::sqrt(front.x * front.x + front.z * front.z);
+    if (frontLength > 1e-4)
+    {
+        m_frontX   = front.x / frontLength;
+        m_frontZ   = front.z / frontLength;
+        m_hasFront = true;
+    }
+
+    m_chunk          = ChunkPos(Mth::floorDiv((int) position.x, Chunk::SIZE_X), 0,
+                                    Mth::floorDiv((int) position.z, Chunk::SIZE_Z));
+    m_predictedChunk = ChunkPos((int) std::floor(m_predictedX), 0, (int) std::floor(m_predictedZ));
+}
+
+int ChunkPriority::score(const ChunkPos &pos) const
+{
+    double dx      = pos.x + 0.5 - m_x;
+    double dz      = pos.z + 0.5 - m_z;
+    double current = std::sqrt(dx * dx + dz * dz);
+    if (current <= NEAR_RADIUS)
+    {
+        return -(int) (current * current * SCORE_SCALE);
+    }
+
+    double px       = pos.x + 0.5 - m_predictedX;
+    double pz       = pos.z + 0.5 - m_predictedZ;
+    double distance = std::sqrt(px * px + pz * pz);
+
+    if (m_hasFront)
+    {
+        double facing = (dx * m_frontX + dz * m_frontZ) / current;
+        if (facing < VIEW_CONE_COS)
+        {
+            distance *= 1.0 + BEHIND_PENALTY * (VIEW_CONE_COS - facing) / (1.0 + VIEW_CONE_COS);
+        }
+    }
+
+    return -(int) (distance * distance * SCORE_SCALE);
+}
+
+bool ChunkPriority::isEquivalent(const ChunkPriority &other) const
+{
+    if (m_chunk != other.m_chunk || m_predictedChunk != other.m_predictedChunk ||
+        m_hasFront != other.m_hasFront)
+    {
+        return false;
+    }
+    return !m_hasFront || m_frontX * other.m_frontX + m_frontZ * other.m_frontZ >= EQUIVALENT_COS;
+}
+
+const ChunkPos &ChunkPriority::getChunk() const { return m_chunk; }
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "../../utils/math/Vec3.h"
+#include "ChunkPos.h"
+
+class ChunkPriority
+{
+public:
+    ChunkPriority();
+    ChunkPriority(const Vec3 &position, const Vec3 &velocity, const Vec3 &front,
+                  int renderDistance);
+
+    int score(const ChunkPos &pos) const;
+    bool isEquivalent(const ChunkPriority &other) const;
+
+    const ChunkPos &getChunk() const;
+
+private:
+    static constexpr double LOOKAHEAD_SECONDS = 1.5;
+    static constexpr double NEAR_RADIUS       = 2.0;
+    static constexpr double VIEW_CONE_COS     = 0.5;
+    static constexpr double BEHIND_PENALTY    = 2.0;
+    static constexpr double EQUIVALENT_COS    = 0.97;
+    static constexpr double SCORE_SCALE       = 16.0;
+
+    double m_x;
+    double m_z;
+    double m_predictedX;
+    double m_predictedZ;
+    double m_frontX;
+    double m_frontZ;
+    bool m_hasFront;
+    ChunkPos m_chunk;
+    ChunkPos m_predictedChunk;
+};
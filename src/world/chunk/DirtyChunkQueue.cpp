@@ -0,0 +1,105 @@
+#include "DirtyChunkQueue.h"
+
+#include <algorithm>
+
+static bool compareScore(const std::pair<int, ChunkPos> &a, const std::pair<int, ChunkPos> &b)
+{
+    return a.first < b.first;
+}
+
+DirtyChunkQueue::DirtyChunkQueue() : m_head(nullptr), m_size(0), m_sortedCount(0) {}
+
+DirtyChunkQueue::~DirtyChunkQueue() { collect(); }
+
+void DirtyChunkQueue::push(const ChunkPos &pos)
+{
+    Node *node = new Node{pos, m_head.load(std::memory_order_relaxed)};
+    while (!m_head.compare_exchange_weak(node->next, node, std::memory_order_release,
+                                         std::memory_order_relaxed))
+    {
+    }
+    m_size.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool DirtyChunkQueue::poll(const ChunkPriority &priority, ChunkPos *outPos)
+{
+    collect();
+    if (m_pending.empty())
+    {
+        return false;
+    }
+
+    if (m_sortedCount == 0 || !priority.isEquivalent(m_priority))
+    {
+        sortPending(priority);
+    }
+    else if (m_sortedCount < m_pending.size())
+    {
+        mergeCollected();
+    }
+
+    *outPos = m_pending.back().second;
+    m_pending.pop_back();
+    m_sortedCount = m_pending.size();
+    m_size.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+void DirtyChunkQueue::drain(std::vector<ChunkPos> *out)
+{
+    collect();
+    m_size.fetch_sub(m_pending.size(), std::memory_order_relaxed);
+    getPending(out);
+    m_pending.clear();
+    m_sortedCount = 0;
+}
+
+void DirtyChunkQueue::getPending(std::vector<ChunkPos> *out) const
+{
+    out->reserve(out->size() + m_pending.size());
+    for (const ScoredPos &entry : m_pending)
+    {
+        out->push_back(entry.second);
+    }
+}
+
+size_t DirtyChunkQueue::size() const { return m_size.load(std::memory_order_relaxed); }
+
+void DirtyChunkQueue::collect()
+{
+    Node *node = m_head.exchange(nullptr, std::memory_order_acquire);
+    while (node)
+    {
+        Node *next = node->next;
+        m_pending.emplace_back(0, node->pos);
+        delete node;
+        node = next;
+    }
+}
+
+void DirtyChunkQueue::sortPending(const ChunkPriority &priority)
+{
+    for (ScoredPos &entry : m_pending)
+    {
+        entry.first = priority.score(entry.second);
+    }
+
+    std::sort(m_pending.begin(), m_pending.end(), compareScore);
+
+    m_sortedCount = m_pending.size();
+    m_priority    = priority;
+}
+
+void DirtyChunkQueue::mergeCollected()
+{
+    std::vector<ScoredPos>::iterator collected = m_pending.begin() + (ptrdiff_t) m_sortedCount;
+    for (std::vector<ScoredPos>::iterator it = collected; it != m_pending.end(); ++it)
+    {
+        it->first = m_priority.score(it->second);
+    }
+
+    std::sort(collected, m_pending.end(), compareScore);
+    std::inplace_merge(m_pending.begin(), collected, m_pending.end(), compareScore);
+
+    m_sortedCount = m_pending.size();
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "ChunkPos.h"
+#include "ChunkPriority.h"
+
+class DirtyChunkQueue
+{
+public:
+    DirtyChunkQueue();
+    ~DirtyChunkQueue();
+
+    DirtyChunkQueue(const DirtyChunkQueue &)            = delete;
+    DirtyChunkQueue &operator=(const DirtyChunkQueue &) = delete;
+
+    void push(const ChunkPos &pos);
+    bool poll(const ChunkPriority &priority, ChunkPos *outPos);
+    void drain(std::vector<ChunkPos> *out);
+
+    void getPending(std::vector<ChunkPos> *out) const;
+    size_t size() const;
+
+private:
+    struct Node
+    {
+        ChunkPos pos;
+        Node *next;
+    };
+
+    using ScoredPos = std::pair<int, ChunkPos>;
+
+    void collect();
+    void sortPending(const ChunkPriority &priority);
+    void mergeCollected();
+
+    std::atomic<Node *> m_head;
+    std::atomic<size_t> m_size;
+    std::vector<ScoredPos> m_pending;
+    size_t m_sortedCount;
+    ChunkPriority m_priority;
+};
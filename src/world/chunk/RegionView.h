@@ -0,0 +1,181 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "../block/Block.h"
+#include "../block/BlockProperties.h"
+#include "Chunk.h"
+#include "ChunkPos.h"
+
+template<typename ChunkType>
+class BasicRegionView
+{
+    static_assert(Chunk::SIZE_X == 16 && Chunk::SIZE_Z == 16,
+                  "region views index chunk columns by shifting world coordinates");
+
+public:
+    static constexpr int CHUNK_SHIFT = 4;
+    static constexpr int LOCAL_MASK  = Chunk::SIZE_X - 1;
+
+    template<typename Source>
+    BasicRegionView(Source &source, int minX, int minZ, int maxX, int maxZ)
+        : m_minChunkX(minX >> CHUNK_SHIFT), m_minChunkZ(minZ >> CHUNK_SHIFT),
+          m_width((maxX >> CHUNK_SHIFT) - m_minChunkX + 1),
+          m_depth((maxZ >> CHUNK_SHIFT) - m_minChunkZ + 1)
+    {
+        size_t count = (size_t) m_width * (size_t) m_depth;
+        m_chunks     = m_inline;
+        if (count > INLINE_CHUNKS)
+        {
+            m_overflow.resize(count);
+            m_chunks = m_overflow.data();
+        }
+
+        for (int dz = 0; dz < m_depth; dz++)
+        {
+            for (int dx = 0; dx < m_width; dx++)
+            {
+                m_chunks[dx + dz * m_width] =
+                        source.getChunk(ChunkPos(m_minChunkX + dx, 0, m_minChunkZ + dz));
+            }
+        }
+    }
+
+    BasicRegionView(const BasicRegionView &)            = delete;
+    BasicRegionView &operator=(const BasicRegionView &) = delete;
+
+    bool contains(int x, int z) const
+    {
+        unsigned cx = (unsigned) ((x >> CHUNK_SHIFT) - m_minChunkX);
+        unsigned cz = (unsigned) ((z >> CHUNK_SHIFT) - m_minChunkZ);
+        return cx < (unsigned) m_width && cz < (unsigned) m_depth;
+    }
+
+    ChunkType *getChunk(int x, int z) const
+    {
+        unsigned cx = (unsigned) ((x >> CHUNK_SHIFT) - m_minChunkX);
+        unsigned cz = (unsigned) ((z >> CHUNK_SHIFT) - m_minChunkZ);
+        if (cx >= (unsigned) m_width || cz >= (unsigned) m_depth)
+        {
+            return nullptr;
+        }
+        return m_chunks[cx + cz * (unsigned) m_width];
+    }
+
+    size_t getColumnCount() const { return (size_t) m_width * (size_t) m_depth; }
+
+    size_t getColumnIndex(int x, int z) const
+    {
+        return (size_t) ((x >> CHUNK_SHIFT) - m_minChunkX) +
+               (size_t) ((z >> CHUNK_SHIFT) - m_minChunkZ) * (size_t) m_width;
+    }
+
+    ChunkPos getColumnPos(size_t index) const
+    {
+        return ChunkPos(m_minChunkX + (int) (index % (size_t) m_width), 0,
+                        m_minChunkZ + (int) (index / (size_t) m_width));
+    }
+
+    ChunkType *getChunk(int x, int y, int z) const
+    {
+        return (unsigned) y < (unsigned) Chunk::SIZE_Y ? getChunk(x, z) : nullptr;
+    }
+
+    uint32_t getBlockId(int x, int y, int z) const
+    {
+        ChunkType *chunk = getChunk(x, y, z);
+        return chunk ? chunk->getBlockId(x & LOCAL_MASK, y, z & LOCAL_MASK) : 0;
+    }
+
+    Block *getBlock(int x, int y, int z) const { return Block::byId(getBlockId(x, y, z)); }
+
+    bool isSolid(int x, int y, int z) const
+    {
+        return BlockProperties::isSolid(getBlockId(x, y, z));
+    }
+
+    uint8_t getSkyLight(int x, int y, int z) const
+    {
+        ChunkType *chunk = getChunk(x, y, z);
+        return chunk ? chunk->getSkyLight(x & LOCAL_MASK, y, z & LOCAL_MASK) : 0;
+    }
+
+    void getBlockLight(int x, int y, int z, uint8_t *r, uint8_t *g, uint8_t *b) const
+    {
+        ChunkType *chunk = getChunk(x, y, z);
+        if (!chunk)
+        {
+            *r = 0;
+            *g = 0;
+            *b = 0;
+            return;
+        }
+        chunk->getBlockLight(x & LOCAL_MASK, y, z & LOCAL_MASK, r, g, b);
+    }
+
+    void getLight(int x, int y, int z, uint8_t *r, uint8_t *g, uint8_t *b) const
+    {
+        ChunkType *chunk = getChunk(x, y, z);
+        if (!chunk)
+        {
+            *r = 0;
+            *g = 0;
+            *b = 0;
+            return;
+        }
+        chunk->getLight(x & LOCAL_MASK, y, z & LOCAL_MASK, r, g, b);
+    }
+
+    void setSkyLight(int x, int y, int z, uint8_t level) const
+    {
+        if (ChunkType *chunk = getChunk(x, y, z))
+        {
+            chunk->setSkyLight(x & LOCAL_MASK, y, z & LOCAL_MASK, level);
+        }
+    }
+
+    void setBlockLight(int x, int y, int z, uint8_t r, uint8_t g, uint8_t b) const
+    {
+        if (ChunkType *chunk = getChunk(x, y, z))
+        {
+            chunk->setBlockLight(x & LOCAL_MASK, y, z & LOCAL_MASK, r, g, b);
+        }
+    }
+
+    template<typename Function>
+    void forEachColumn(int minX, int minZ, int maxX, int maxZ, Function &&function) const
+    {
+        for (int cz = minZ >> CHUNK_SHIFT; cz <= maxZ >> CHUNK_SHIFT; cz++)
+        {
+            int z0 = cz << CHUNK_SHIFT;
+            for (int cx = minX >> CHUNK_SHIFT; cx <= maxX >> CHUNK_SHIFT; cx++)
+            {
+                int x0           = cx << CHUNK_SHIFT;
+                ChunkType *chunk = getChunk(x0, z0);
+                for (int z = z0 < minZ ? minZ : z0; z <= maxZ && z < z0 + Chunk::SIZE_Z; z++)
+                {
+                    for (int x = x0 < minX ? minX : x0; x <= maxX && x < x0 + Chunk::SIZE_X; x++)
+                    {
+                        function(chunk, x, z, x & LOCAL_MASK, z & LOCAL_MASK);
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    static constexpr size_t INLINE_CHUNKS = 25;
+
+    int m_minChunkX;
+    int m_minChunkZ;
+    int m_width;
+    int m_depth;
+    ChunkType *m_inline[INLINE_CHUNKS];
+    std::vector<ChunkType *> m_overflow;
+    ChunkType **m_chunks;
+};
+
+using RegionView      = BasicRegionView<Chunk>;
+using ConstRegionView = BasicRegionView<const Chunk>;
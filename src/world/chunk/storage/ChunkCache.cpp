@@ -1,6 +1,64 @@
 #include "ChunkCache.h"
 
-ChunkCache::ChunkCache() : m_entries() {}
+std::atomic<uint64_t> ChunkCache::s_nextId{1};
+
+ChunkCache::Grid::Grid(int span)
+    : span(span), mask(span - 1), slots(new std::atomic<Chunk *>[(size_t) span * span])
+{
+    for (size_t i = 0; i < (size_t) span * span; i++)
+    {
+        slots[i].store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+ChunkCache::ChunkCache() : m_id(s_nextId.fetch_add(1)), m_grid(nullptr), m_size(0), m_overflow(0)
+{
+    m_grids.push_back(std::make_unique<Grid>(1));
+    m_grid.store(m_grids.back().get());
+}
+
+void ChunkCache::rebuild(int radius, const std::unordered_map<ChunkPos, std::unique_ptr<Chunk>,
+                                                              ChunkPosHash> &chunks)
+{
+    int span = 1;
+    while (span < radius * 2 + 1)
+    {
+        span <<= 1;
+    }
+
+    std::unique_ptr<Grid> grid = std::make_unique<Grid>(span);
+
+    size_t size     = 0;
+    size_t overflow = 0;
+    for (const auto &[pos, chunk] : chunks)
+    {
+        if (place(grid.get(), pos, chunk.get()))
+        {
+            size++;
+        }
+        else
+        {
+            overflow++;
+        }
+    }
+
+    m_size.store(size);
+    m_overflow.store(overflow);
+    m_grid.store(grid.get(), std::memory_order_release);
+    m_grids.push_back(std::move(grid));
+}
+
+bool ChunkCache::place(Grid *grid, const ChunkPos &pos, Chunk *chunk)
+{
+    std::atomic<Chunk *> &slot = grid->slots[grid->index(pos)];
+    if (slot.load(std::memory_order_relaxed))
+    {
+        return false;
+    }
+
+    slot.store(chunk, std::memory_order_release);
+    return true;
+}
 
 void ChunkCache::put(const ChunkPos &pos, Chunk *chunk)
 {
@@ -9,31 +67,47 @@ void ChunkCache::put(const ChunkPos &pos, Chunk *chunk)
         return;
     }
 
-    m_entries[pos] = chunk;
+    if (place(m_grid.load(), pos, chunk))
+    {
+        m_size.fetch_add(1);
+    }
+    else
+    {
+        m_overflow.fetch_add(1);
+    }
 }
 
-void ChunkCache::erase(const ChunkPos &pos) { m_entries.erase(pos); }
-
-void ChunkCache::clear() { m_entries.clear(); }
-
-Chunk *ChunkCache::get(const ChunkPos &pos)
+void ChunkCache::erase(const ChunkPos &pos)
 {
-    auto it = m_entries.find(pos);
-    if (it == m_entries.end())
+    Grid *grid                 = m_grid.load();
+    std::atomic<Chunk *> &slot = grid->slots[grid->index(pos)];
+
+    Chunk *chunk = slot.load(std::memory_order_relaxed);
+    if (chunk && chunk->getPos() == pos)
     {
-        return nullptr;
+        slot.store(nullptr, std::memory_order_release);
+        m_size.fetch_sub(1);
+    }
+    else
+    {
+        m_overflow.fetch_sub(1);
     }
-    return it->second;
 }
 
-const Chunk *ChunkCache::get(const ChunkPos &pos) const
+void ChunkCache::clear()
 {
-    auto it = m_entries.find(pos);
-    if (it == m_entries.end())
+    Grid *grid = m_grid.load();
+    for (size_t i = 0; i < (size_t) grid->span * grid->span; i++)
     {
-        return nullptr;
+        grid->slots[i].store(nullptr, std::memory_order_release);
     }
-    return it->second;
+
+    m_size.store(0);
+    m_overflow.store(0);
 }
 
-size_t ChunkCache::size() const { return m_entries.size(); }
+bool ChunkCache::hasOverflow() const { return m_overflow.load(std::memory_order_relaxed) != 0; }
+
+size_t ChunkCache::size() const { return m_size.load(); }
+
+int ChunkCache::getSpan() const { return m_grid.load()->span; }
@@ -1,7 +1,11 @@
 #pragma once
 
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <unordered_map>
+#include <vector>
 
 #include "../Chunk.h"
 #include "../ChunkPos.h"
@@ -11,15 +15,78 @@ class ChunkCache
 public:
     ChunkCache();
 
+    void rebuild(int radius, const std::unordered_map<ChunkPos, std::unique_ptr<Chunk>,
+                                                      ChunkPosHash> &chunks);
     void put(const ChunkPos &pos, Chunk *chunk);
     void erase(const ChunkPos &pos);
     void clear();
 
-    Chunk *get(const ChunkPos &pos);
-    const Chunk *get(const ChunkPos &pos) const;
+    Chunk *get(const ChunkPos &pos) const
+    {
+        const Grid *grid    = m_grid.load(std::memory_order_acquire);
+        RecentEntry &recent = s_recent[((size_t) pos.x * 31 + (size_t) pos.z) & RECENT_MASK];
+        if (recent.owner == m_id && recent.grid == grid && recent.x == pos.x &&
+            recent.y == pos.y && recent.z == pos.z &&
+            recent.slot->load(std::memory_order_acquire) == recent.chunk &&
+            (!recent.chunk || recent.chunk->getPos() == pos))
+        {
+            return recent.chunk;
+        }
 
+        const std::atomic<Chunk *> &slot = grid->slots[grid->index(pos)];
+        Chunk *chunk                     = slot.load(std::memory_order_acquire);
+        if (chunk && chunk->getPos() != pos)
+        {
+            chunk = nullptr;
+        }
+
+        recent = {m_id, grid, &slot, chunk, pos.x, pos.y, pos.z};
+        return chunk;
+    }
+
+    bool hasOverflow() const;
     size_t size() const;
+    int getSpan() const;
 
 private:
-    std::unordered_map<ChunkPos, Chunk *, ChunkPosHash> m_entries;
+    static constexpr size_t RECENT_SIZE = 16;
+    static constexpr size_t RECENT_MASK = RECENT_SIZE - 1;
+
+    struct Grid;
+
+    struct RecentEntry
+    {
+        uint64_t owner;
+        const Grid *grid;
+        const std::atomic<Chunk *> *slot;
+        Chunk *chunk;
+        int x;
+        int y;
+        int z;
+    };
+
+    struct Grid
+    {
+        explicit Grid(int span);
+
+        size_t index(const ChunkPos &pos) const
+        {
+            return (size_t) (pos.x & mask) + (size_t) (pos.z & mask) * (size_t) span;
+        }
+
+        int span;
+        int mask;
+        std::unique_ptr<std::atomic<Chunk *>[]> slots;
+    };
+
+    static bool place(Grid *grid, const ChunkPos &pos, Chunk *chunk);
+
+    static inline thread_local RecentEntry s_recent[RECENT_SIZE]{};
+    static std::atomic<uint64_t> s_nextId;
+
+    uint64_t m_id;
+    std::atomic<Grid *> m_grid;
+    std::vector<std::unique_ptr<Grid>> m_grids;
+    std::atomic<size_t> m_size;
+    std::atomic<size_t> m_overflow;
 };
@@ -0,0 +1,265 @@
+#include "ChunkStorage.h"
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <random>
+#include <string>
+
+#include "../../../core/Logger.h"
+
+ChunkStorage::ChunkStorage(const std::filesystem::path &directory)
+    : m_directory(directory), m_ownsDirectory(false), m_lostCount(0), m_generateTime(0.0),
+      m_saveTime(0.0), m_loadTime(0.0), m_hasGenerateTime(false), m_hasSaveTime(false),
+      m_hasLoadTime(false)
+{
+    std::error_code error;
+    std::filesystem::create_directories(m_directory, error);
+    if (error)
+    {
+        Logger::logError("Failed to create chunk storage at %s", m_directory.string().c_str());
+    }
+}
+
+ChunkStorage::~ChunkStorage()
+{
+    if (m_ownsDirectory)
+    {
+        std::error_code error;
+        std::filesystem::remove_all(m_directory, error);
+    }
+}
+
+std::unique_ptr<ChunkStorage> ChunkStorage::createTemporary()
+{
+    std::error_code error;
+    std::filesystem::path root = std::filesystem::temp_directory_path(error);
+    if (error)
+    {
+        root = std::filesystem::current_path(error);
+    }
+
+    uint64_t seed = (uint64_t) std::chrono::steady_clock::now().time_since_epoch().count() ^
+                    (uint64_t) std::random_device()();
+    for (int attempt = 0; attempt < TEMPORARY_ATTEMPTS; attempt++)
+    {
+        std::filesystem::path directory =
+                root / ("minecraftclone-chunks-" + std::to_string(seed + (uint64_t) attempt));
+        if (std::filesystem::create_directory(directory, error))
+        {
+            std::unique_ptr<ChunkStorage> storage = std::make_unique<ChunkStorage>(directory);
+            storage->m_ownsDirectory              = true;
+            return storage;
+        }
+    }
+
+    Logger::logError("Failed to create temporary chunk storage in %s", root.string().c_str());
+    return nullptr;
+}
+
+bool ChunkStorage::save(const Chunk &chunk)
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    const ChunkPos &pos = chunk.getPos();
+    std::ofstream out(getPath(pos), std::ios::binary | std::ios::trunc);
+    if (!out)
+    {
+        return false;
+    }
+
+    chunk.write(out);
+    out.close();
+    if (!out)
+    {
+        return false;
+    }
+
+    double seconds =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_stored[pos] = chunk.isUnmodified();
+    recordTime(&m_saveTime, &m_hasSaveTime, seconds);
+    return true;
+}
+
+std::unique_ptr<Chunk> ChunkStorage::load(const ChunkPos &pos)
+{
+    bool unmodified;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto it = m_stored.find(pos);
+        if (it == m_stored.end())
+        {
+            return nullptr;
+        }
+        unmodified = it->second;
+    }
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    std::ifstream in(getPath(pos), std::ios::binary);
+    if (!in)
+    {
+        discard(pos, unmodified, "unreadable");
+        return nullptr;
+    }
+
+    std::unique_ptr<Chunk> chunk = std::make_unique<Chunk>(pos);
+    if (!chunk->read(in))
+    {
+        in.close();
+        discard(pos, unmodified, "corrupt");
+        return nullptr;
+    }
+
+    chunk->setUnmodified(unmodified);
+
+    double seconds =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    recordTime(&m_loadTime, &m_hasLoadTime, seconds);
+    return chunk;
+}
+
+bool ChunkStorage::has(const ChunkPos &pos) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stored.find(pos) != m_stored.end();
+}
+
+bool ChunkStorage::shouldLoad(const ChunkPos &pos) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_stored.find(pos);
+    if (it == m_stored.end())
+    {
+        return false;
+    }
+    if (!it->second || !m_hasGenerateTime)
+    {
+        return true;
+    }
+    return getLoadEstimate() < m_generateTime;
+}
+
+void ChunkStorage::remove(const ChunkPos &pos)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (m_stored.erase(pos) == 0)
+        {
+            return;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::remove(getPath(pos), error);
+}
+
+void ChunkStorage::recordGenerateTime(double seconds)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    recordTime(&m_generateTime, &m_hasGenerateTime, seconds);
+}
+
+bool ChunkStorage::shouldStoreUnmodified() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (!m_hasGenerateTime || !m_hasSaveTime)
+    {
+        return false;
+    }
+    return m_saveTime + getLoadEstimate() < m_generateTime;
+}
+
+size_t ChunkStorage::getStoredCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stored.size();
+}
+
+size_t ChunkStorage::getLostCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_lostCount;
+}
+
+double ChunkStorage::getAverageGenerateTime() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_generateTime;
+}
+
+double ChunkStorage::getAverageSaveTime() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_saveTime;
+}
+
+double ChunkStorage::getAverageLoadTime() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_loadTime;
+}
+
+std::filesystem::path ChunkStorage::getPath(const ChunkPos &pos) const
+{
+    return m_directory / ("c." + std::to_string(pos.x) + "." + std::to_string(pos.y) + "." +
+                          std::to_string(pos.z) + ".bin");
+}
+
+void ChunkStorage::discard(const ChunkPos &pos, bool unmodified, const char *reason)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (m_stored.erase(pos) == 0)
+        {
+            return;
+        }
+        if (!unmodified)
+        {
+            m_lostCount++;
+        }
+    }
+
+    std::filesystem::path path = getPath(pos);
+    std::error_code error;
+    if (unmodified)
+    {
+        Logger::logWarn("Discarding %s stored chunk (%d, %d, %d)", reason, pos.x, pos.y, pos.z);
+        std::filesystem::remove(path, error);
+        return;
+    }
+
+    std::filesystem::path lostPath = path;
+    lostPath += ".lost";
+    std::filesystem::rename(path, lostPath, error);
+    Logger::logError("Lost edits in %s stored chunk (%d, %d, %d), regenerating it; old data %s %s",
+                     reason, pos.x, pos.y, pos.z, error ? "could not be moved from" : "kept in",
+                     (error ? path : lostPath).string().c_str());
+}
+
+double ChunkStorage::getLoadEstimate() const { return m_hasLoadTime ? m_loadTime : m_saveTime; }
+
+void ChunkStorage::recordTime(double *average, bool *hasSample, double seconds)
+{
+    if (!*hasSample)
+    {
+        *average   = seconds;
+        *hasSample = true;
+        return;
+    }
+
+    *average += (seconds - *average) * 0.1;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "../Chunk.h"
+#include "../ChunkPos.h"
+
+class ChunkStorage
+{
+public:
+    explicit ChunkStorage(const std::filesystem::path &directory);
+    ~ChunkStorage();
+
+    ChunkStorage(const ChunkStorage &)            = delete;
+    ChunkStorage &operator=(const ChunkStorage &) = delete;
+
+    static std::unique_ptr<ChunkStorage> createTemporary();
+
+    bool save(const Chunk &chunk);
+    std::unique_ptr<Chunk> load(const ChunkPos &pos);
+    bool has(const ChunkPos &pos) const;
+    bool shouldLoad(const ChunkPos &pos) const;
+    void remove(const ChunkPos &pos);
+
+    void recordGenerateTime(double seconds);
+    bool shouldStoreUnmodified() const;
+
+    size_t getStoredCount() const;
+    size_t getLostCount() const;
+    double getAverageGenerateTime() const;
+    double getAverageSaveTime() const;
+    double getAverageLoadTime() const;
+
+private:
+    static constexpr int TEMPORARY_ATTEMPTS = 16;
+
+    std::filesystem::path getPath(const ChunkPos &pos) const;
+    void discard(const ChunkPos &pos, bool unmodified, const char *reason);
+    double getLoadEstimate() const;
+    static void recordTime(double *average, bool *hasSample, double seconds);
+
+    std::filesystem::path m_directory;
+    bool m_ownsDirectory;
+    std::unordered_map<ChunkPos, bool, ChunkPosHash> m_stored;
+    size_t m_lostCount;
+
+    double m_generateTime;
+    double m_saveTime;
+    double m_loadTime;
+    bool m_hasGenerateTime;
+    bool m_hasSaveTime;
+    bool m_hasLoadTime;
+    mutable std::mutex m_mutex;
+};
@@ -2,9 +2,15 @@
 
 #include <cmath>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 #include "../../utils/math/Mth.h"
 #include "../biome/BiomeRegistry.h"
-#include "../block/Block.h"
+#include "../biome/Biomes.h"
+#include "../block/BlockProperties.h"
+#include "../block/Blocks.h"
 #include "../chunk/Chunk.h"
 
 static inline int getGridIndex(int gx, int gy, int gz)
@@ -122,68 +128,18 @@ void TerrainGenerator::generate(Level &level, const ChunkPos &center)
 
 void TerrainGenerator::generateChunk(Chunk &chunk, const ChunkPos &chunkPos)
 {
-    Block *bedrock  = Block::byName("bedrock");
-    Block *stone    = Block::byName("stone");
-    Block *andesite = Block::byName("andesite");
-    Block *sand     = Block::byName("sand");
-    Block *gravel   = Block::byName("gravel");
-    Block *water    = Block::byName("air");
-
-    const int seaLevel    = 64;
+    uint32_t bedrock  = Blocks::BEDROCK.getId();
+    uint32_t stone    = Blocks::STONE.getId();
+    uint32_t andesite = Blocks::ANDESITE.getId();
+    uint32_t water    = Blocks::AIR.getId();
+
     const int bedrockCeil = 5;
 
     float grid[GRID_X * GRID_Y * GRID_Z];
     buildDensityGrid(grid, chunkPos.x, chunkPos.z);
 
     int heightMap[Chunk::SIZE_X * Chunk::SIZE_Z];
-
-    for (int z = 0; z < Chunk::SIZE_Z; z++)
-    {
-        for (int x = 0; x < Chunk::SIZE_X; x++)
-        {
-            int gx0  = x / CELL_XZ;
-            int gz0  = z / CELL_XZ;
-            int gx1  = gx0 + 1;
-            int gz1  = gz0 + 1;
-            float tx = (float) (x % CELL_XZ) / CELL_XZ;
-            float tz = (float) (z % CELL_XZ) / CELL_XZ;
-
-            int height = 0;
-            for (int y = Chunk::SIZE_Y - 1; y >= 1; y--)
-            {
-                int gy0  = y / CELL_Y;
-                int gy1  = gy0 + 1;
-                float ty = (float) (y % CELL_Y) / CELL_Y;
-                if (gy1 >= GRID_Y)
-                    continue;
-
-                float d000 = grid[getGridIndex(gx0, gy0, gz0)];
-                float d100 = grid[getGridIndex(gx1, gy0, gz0)];
-                float d010 = grid[getGridIndex(gx0, gy1, gz0)];
-                float d110 = grid[getGridIndex(gx1, gy1, gz0)];
-                float d001 = grid[getGridIndex(gx0, gy0, gz1)];
-                float d101 = grid[getGridIndex(gx1, gy0, gz1)];
-                float d011 = grid[getGridIndex(gx0, gy1, gz1)];
-                float d111 = grid[getGridIndex(gx1, gy1, gz1)];
-
-                float c00     = Mth::lerpf(d000, d100, tx);
-                float c10     = Mth::lerpf(d010, d110, tx);
-                float c01     = Mth::lerpf(d001, d101, tx);
-                float c11     = Mth::lerpf(d011, d111, tx);
-                float c0      = Mth::lerpf(c00, c01, tz);
-                float c1      = Mth::lerpf(c10, c11, tz);
-                float density = Mth::lerpf(c0, c1, ty);
-
-                if (density > 0.0f && height == 0)
-                {
-                    height = y;
-                    break;
-                }
-            }
-
-            heightMap[x + z * Chunk::SIZE_X] = height;
-        }
-    }
+    float density[Chunk::SIZE_Y];
 
     for (int z = 0; z < Chunk::SIZE_Z; z++)
     {
@@ -192,67 +148,24 @@ void TerrainGenerator::generateChunk(Chunk &chunk, const ChunkPos &chunkPos)
             int levelX = chunkPos.x * Chunk::SIZE_X + x;
             int levelZ = chunkPos.z * Chunk::SIZE_Z + z;
 
-            int gx0  = x / CELL_XZ;
-            int gz0  = z / CELL_XZ;
-            int gx1  = gx0 + 1;
-            int gz1  = gz0 + 1;
-            float tx = (float) (x % CELL_XZ) / CELL_XZ;
-            float tz = (float) (z % CELL_XZ) / CELL_XZ;
+            interpolateColumn(grid, x, z, density);
 
-            int height = heightMap[x + z * Chunk::SIZE_X];
+            int height                       = findSurface(density);
+            heightMap[x + z * Chunk::SIZE_X] = height;
 
             Biome *biome = getBiomeAt(levelX, levelZ);
             if (!biome)
-                biome = Biome::byName("plains");
+                biome = Biomes::PLAINS;
 
             chunk.setBiomeAt(x, z, biome);
 
-            Block *top;
-            Block *filler;
-            if (height < seaLevel - 1)
-            {
-                top    = gravel;
-                filler = gravel;
-            }
-            else if (height <= seaLevel + 1)
-            {
-                top    = sand;
-                filler = sand;
-            }
-            else
-            {
-                top    = biome->getTopBlock();
-                filler = biome->getFillerBlock();
-            }
+            uint32_t top;
+            uint32_t filler;
+            selectSurfaceBlocks(height, biome, &top, &filler);
 
             for (int y = 1; y < Chunk::SIZE_Y; y++)
             {
-                int gy0  = y / CELL_Y;
-                int gy1  = gy0 + 1;
-                float ty = (float) (y % CELL_Y) / CELL_Y;
-                if (gy1 >= GRID_Y)
-                {
-                    continue;
-                }
-
-                float d000 = grid[getGridIndex(gx0, gy0, gz0)];
-                float d100 = grid[getGridIndex(gx1, gy0, gz0)];
-                float d010 = grid[getGridIndex(gx0, gy1, gz0)];
-                float d110 = grid[getGridIndex(gx1, gy1, gz0)];
-                float d001 = grid[getGridIndex(gx0, gy0, gz1)];
-                float d101 = grid[getGridIndex(gx1, gy0, gz1)];
-                float d011 = grid[getGridIndex(gx0, gy1, gz1)];
-                float d111 = grid[getGridIndex(gx1, gy1, gz1)];
-
-                float c00     = Mth::lerpf(d000, d100, tx);
-                float c10     = Mth::lerpf(d010, d110, tx);
-                float c01     = Mth::lerpf(d001, d101, tx);
-                float c11     = Mth::lerpf(d011, d111, tx);
-                float c0      = Mth::lerpf(c00, c01, tz);
-                float c1      = Mth::lerpf(c10, c11, tz);
-                float density = Mth::lerpf(c0, c1, ty);
-
-                if (density <= 0.0f)
+                if (density[y] <= 0.0f)
                 {
                     continue;
                 }
@@ -265,18 +178,18 @@ void TerrainGenerator::generateChunk(Chunk &chunk, const ChunkPos &chunkPos)
                     rockNoise       = (rockNoise + 1.0f) * 0.5f;
                     if (rockNoise < 1.0f - bt * bt)
                     {
-                        chunk.setBlock(x, y, z, bedrock);
+                        chunk.setBlockId(x, y, z, bedrock);
                         continue;
                     }
                 }
 
                 if (y == height)
                 {
-                    chunk.setBlock(x, y, z, top);
+                    chunk.setBlockId(x, y, z, top);
                 }
                 else if (y >= height - 4)
                 {
-                    chunk.setBlock(x, y, z, filler);
+                    chunk.setBlockId(x, y, z, filler);
                 }
                 else
                 {
@@ -284,16 +197,16 @@ void TerrainGenerator::generateChunk(Chunk &chunk, const ChunkPos &chunkPos)
                     rock       = (rock + 1.0f) * 0.5f;
                     if (rock > 0.62f)
                     {
-                        chunk.setBlock(x, y, z, andesite);
+                        chunk.setBlockId(x, y, z, andesite);
                     }
                     else
                     {
-                        chunk.setBlock(x, y, z, stone);
+                        chunk.setBlockId(x, y, z, stone);
                     }
                 }
             }
 
-            chunk.setBlock(x, 0, z, bedrock);
+            chunk.setBlockId(x, 0, z, bedrock);
         }
     }
 
@@ -302,13 +215,10 @@ void TerrainGenerator::generateChunk(Chunk &chunk, const ChunkPos &chunkPos)
         for (int x = 0; x < Chunk::SIZE_X; x++)
         {
             int height = heightMap[x + z * Chunk::SIZE_X];
-            if (height < seaLevel)
+            if (height < SEA_LEVEL)
             {
                 int wy0 = (height <= 0) ? 1 : (height + 1);
-                for (int wy = wy0; wy <= seaLevel && wy < Chunk::SIZE_Y; wy++)
-                {
-                    chunk.setBlock(x, wy, z, water);
-                }
+                chunk.fillColumn(x, z, wy0, SEA_LEVEL, water);
             }
         }
     }
@@ -323,6 +233,8 @@ void TerrainGenerator::generateChunk(Chunk &chunk, const ChunkPos &chunkPos)
             carveCavesFromSourceChunk(chunk, chunkPos, sourceChunkX, sourceChunkZ);
         }
     }
+
+    chunk.setUnmodified(true);
 }
 
 int TerrainGenerator::getHeightAt(int levelX, int levelZ)
@@ -335,41 +247,84 @@ int TerrainGenerator::getHeightAt(int levelX, int levelZ)
     float grid[GRID_X * GRID_Y * GRID_Z];
     buildDensityGrid(grid, chunkX, chunkZ);
 
-    int gx0  = lx / CELL_XZ;
-    int gz0  = lz / CELL_XZ;
+    float density[Chunk::SIZE_Y];
+    interpolateColumn(grid, lx, lz, density);
+
+    return findSurface(density);
+}
+
+void TerrainGenerator::selectSurfaceBlocks(int height, const Biome *biome, uint32_t *top,
+                                           uint32_t *filler) const
+{
+    if (height < SEA_LEVEL - 1)
+    {
+        *top    = Blocks::GRAVEL.getId();
+        *filler = Blocks::GRAVEL.getId();
+    }
+    else if (height <= SEA_LEVEL + 1)
+    {
+        *top    = Blocks::SAND.getId();
+        *filler = Blocks::SAND.getId();
+    }
+    else
+    {
+        *top    = biome->getTopBlockId().getId();
+        *filler = biome->getFillerBlockId().getId();
+    }
+}
+
+void TerrainGenerator::interpolateColumn(const float *grid, int x, int z, float *density) const
+{
+    int gx0  = x / CELL_XZ;
+    int gz0  = z / CELL_XZ;
     int gx1  = gx0 + 1;
     int gz1  = gz0 + 1;
-    float tx = (float) (lx % CELL_XZ) / CELL_XZ;
-    float tz = (float) (lz % CELL_XZ) / CELL_XZ;
+    float tx = (float) (x % CELL_XZ) / CELL_XZ;
+    float tz = (float) (z % CELL_XZ) / CELL_XZ;
 
-    for (int y = Chunk::SIZE_Y - 1; y >= 1; y--)
+    const float *d00 = grid + getGridIndex(gx0, 0, gz0);
+    const float *d10 = grid + getGridIndex(gx1, 0, gz0);
+    const float *d01 = grid + getGridIndex(gx0, 0, gz1);
+    const float *d11 = grid + getGridIndex(gx1, 0, gz1);
+
+    float ramp[GRID_Y];
+    for (int gy = 0; gy < GRID_Y; gy++)
+    {
+        float c0 = Mth::lerpf(d00[gy], d10[gy], tx);
+        float c1 = Mth::lerpf(d01[gy], d11[gy], tx);
+        ramp[gy] = Mth::lerpf(c0, c1, tz);
+    }
+
+    expandRamp(ramp, density);
+}
+
+void TerrainGenerator::expandRamp(const float *ramp, float *density)
+{
+#if defined(__SSE2__)
+    static_assert(CELL_Y == 4);
+    const __m128 ty = _mm_setr_ps(0.0f, 0.25f, 0.5f, 0.75f);
+    for (int gy = 0; gy < GRID_Y - 1; gy++)
+    {
+        __m128 lo   = _mm_set1_ps(ramp[gy]);
+        __m128 step = _mm_set1_ps(ramp[gy + 1] - ramp[gy]);
+        _mm_storeu_ps(density + gy * CELL_Y, _mm_add_ps(lo, _mm_mul_ps(step, ty)));
+    }
+#else
+    for (int gy = 0; gy < GRID_Y - 1; gy++)
     {
-        int gy0  = y / CELL_Y;
-        int gy1  = gy0 + 1;
-        float ty = (float) (y % CELL_Y) / CELL_Y;
-        if (gy1 >= GRID_Y)
+        for (int i = 0; i < CELL_Y; i++)
         {
-            continue;
+            density[gy * CELL_Y + i] = Mth::lerpf(ramp[gy], ramp[gy + 1], (float) i / CELL_Y);
         }
+    }
+#endif
+}
 
-        float d000 = grid[getGridIndex(gx0, gy0, gz0)];
-        float d100 = grid[getGridIndex(gx1, gy0, gz0)];
-        float d010 = grid[getGridIndex(gx0, gy1, gz0)];
-        float d110 = grid[getGridIndex(gx1, gy1, gz0)];
-        float d001 = grid[getGridIndex(gx0, gy0, gz1)];
-        float d101 = grid[getGridIndex(gx1, gy0, gz1)];
-        float d011 = grid[getGridIndex(gx0, gy1, gz1)];
-        float d111 = grid[getGridIndex(gx1, gy1, gz1)];
-
-        float c00     = Mth::lerpf(d000, d100, tx);
-        float c10     = Mth::lerpf(d010, d110, tx);
-        float c01     = Mth::lerpf(d001, d101, tx);
-        float c11     = Mth::lerpf(d011, d111, tx);
-        float c0      = Mth::lerpf(c00, c01, tz);
-        float c1      = Mth::lerpf(c10, c11, tz);
-        float density = Mth::lerpf(c0, c1, ty);
-
-        if (density > 0.0f)
+int TerrainGenerator::findSurface(const float *density)
+{
+    for (int y = Chunk::SIZE_Y - 1; y >= 1; y--)
+    {
+        if (density[y] > 0.0f)
         {
             return y;
         }
@@ -386,9 +341,9 @@ Biome *TerrainGenerator::getBiomeAt(int levelX, int levelZ) const
     humidity       = (humidity + 1.0f) * 0.5f;
     if (temp > 0.55f)
     {
-        return Biome::byName("desert");
+        return Biomes::DESERT;
     }
-    return Biome::byName("plains");
+    return Biomes::PLAINS;
 }
 
 void TerrainGenerator::buildDensityGrid(float *grid, int chunkX, int chunkZ)
@@ -396,50 +351,51 @@ void TerrainGenerator::buildDensityGrid(float *grid, int chunkX, int chunkZ)
     for (int gx = 0; gx < GRID_X; gx++)
     {
         int levelX = chunkX * Chunk::SIZE_X + gx * CELL_XZ;
-
-        double nxBase  = (double) levelX / (double) COORD_SCALE;
-        double nxMain  = (double) levelX / ((double) COORD_SCALE / 80.0);
-        double nxDepth = (double) levelX / (double) DEPTH_SCALE;
-
         for (int gz = 0; gz < GRID_Z; gz++)
         {
             int levelZ = chunkZ * Chunk::SIZE_Z + gz * CELL_XZ;
+            buildDensityColumn(grid + getGridIndex(gx, 0, gz), levelX, levelZ);
+        }
+    }
+}
 
-            double nzBase  = (double) levelZ / (double) COORD_SCALE;
-            double nzMain  = (double) levelZ / ((double) COORD_SCALE / 80.0);
-            double nzDepth = (double) levelZ / (double) DEPTH_SCALE;
+void TerrainGenerator::buildDensityColumn(float *column, int levelX, int levelZ)
+{
+    double nxBase  = (double) levelX / (double) COORD_SCALE;
+    double nxMain  = (double) levelX / ((double) COORD_SCALE / 80.0);
+    double nxDepth = (double) levelX / (double) DEPTH_SCALE;
 
-            float depthRaw = m_depthNoise.GetNoise((float) nxDepth, (float) nzDepth);
-            depthRaw       = Mth::clamp(depthRaw, -1.0f, 1.0f);
+    double nzBase  = (double) levelZ / (double) COORD_SCALE;
+    double nzMain  = (double) levelZ / ((double) COORD_SCALE / 80.0);
+    double nzDepth = (double) levelZ / (double) DEPTH_SCALE;
 
-            for (int gy = 0; gy < GRID_Y; gy++)
-            {
-                double levelY = (double) (gy * CELL_Y);
+    float depthRaw = m_depthNoise.GetNoise((float) nxDepth, (float) nzDepth);
+    depthRaw       = Mth::clamp(depthRaw, -1.0f, 1.0f);
 
-                double nyBase = levelY / (double) HEIGHT_SCALE;
-                double nyMain = levelY / ((double) HEIGHT_SCALE / 160.0);
+    for (int gy = 0; gy < GRID_Y; gy++)
+    {
+        double levelY = (double) (gy * CELL_Y);
 
-                float lower =
-                        m_lowerNoise.GetNoise((float) nxBase, (float) nyBase, (float) nzBase) *
-                        512.0f;
-                float upper =
-                        m_upperNoise.GetNoise((float) nxBase, (float) nyBase, (float) nzBase) *
-                        512.0f;
-                float main = (m_mainNoise.GetNoise((float) nxMain, (float) nyMain, (float) nzMain) +
-                              1.0f) *
-                             0.5f;
-                main = Mth::clamp(main, 0.0f, 1.0f);
+        double nyBase = levelY / (double) HEIGHT_SCALE;
+        double nyMain = levelY / ((double) HEIGHT_SCALE / 160.0);
 
-                float density = Mth::lerpf(lower, upper, main);
+        float lower =
+                m_lowerNoise.GetNoise((float) nxBase, (float) nyBase, (float) nzBase) * 512.0f;
+        float upper =
+                m_upperNoise.GetNoise((float) nxBase, (float) nyBase, (float) nzBase) * 512.0f;
+        float main =
+                (m_mainNoise.GetNoise((float) nxMain, (float) nyMain, (float) nzMain) + 1.0f) *
+                0.5f;
+        main = Mth::clamp(main, 0.0f, 1.0f);
 
-                float yBias = (BASE_SIZE - (float) gy) / STRETCH_Y;
-                yBias += depthRaw;
+        float density = Mth::lerpf(lower, upper, main);
 
-                density = density / 512.0f + yBias;
+        float yBias = (BASE_SIZE - (float) gy) / STRETCH_Y;
+        yBias += depthRaw;
 
-                grid[getGridIndex(gx, gy, gz)] = density;
-            }
-        }
+        density = density / 512.0f + yBias;
+
+        column[gy] = density;
     }
 }
 
@@ -464,8 +420,8 @@ void TerrainGenerator::carveEllipsoid(Chunk &chunk, const ChunkPos &chunkPos, do
     double invRadiusHorizontal = 1.0 / radiusHorizontal;
     double invRadiusVertical   = 1.0 / radiusVertical;
 
-    Block *bedrock = Block::byName("bedrock");
-    Block *air     = Block::byName("air");
+    uint32_t bedrock = Blocks::BEDROCK.getId();
+    uint32_t air     = Blocks::AIR.getId();
 
     for (int localX = minX; localX <= maxX; localX++)
     {
@@ -496,13 +452,13 @@ void TerrainGenerator::carveEllipsoid(Chunk &chunk, const ChunkPos &chunkPos, do
                     continue;
                 }
 
-                int currentId = chunk.getBlockId(localX, localY, localZ);
-                if (Block::byId(currentId) == bedrock)
+                uint32_t currentId = chunk.getBlockId(localX, localY, localZ);
+                if (currentId == bedrock)
                 {
                     continue;
                 }
 
-                chunk.setBlock(localX, localY, localZ, air);
+                chunk.setBlockId(localX, localY, localZ, air);
             }
         }
     }
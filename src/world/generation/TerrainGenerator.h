@@ -24,9 +24,18 @@ public:
     static constexpr int CELL_XZ = 4;
     static constexpr int CELL_Y  = 4;
 
+    static constexpr int SEA_LEVEL = 64;
+
+    static_assert((GRID_Y - 1) * CELL_Y == Chunk::SIZE_Y);
+
 private:
     Biome *getBiomeAt(int levelX, int levelZ) const;
     void buildDensityGrid(float *grid, int chunkX, int chunkZ);
+    void buildDensityColumn(float *column, int levelX, int levelZ);
+    void interpolateColumn(const float *grid, int x, int z, float *density) const;
+    static void expandRamp(const float *ramp, float *density);
+    static int findSurface(const float *density);
+    void selectSurfaceBlocks(int height, const Biome *biome, uint32_t *top, uint32_t *filler) const;
 
     void carveCavesFromSourceChunk(Chunk &chunk, const ChunkPos &targetChunkPos, int sourceChunkX,
                                    int sourceChunkZ);
@@ -1,13 +1,18 @@
 #include "LightEngine.h"
 
-#include <unordered_map>
-#include <unordered_set>
+#include <algorithm>
+#include <shared_mutex>
+#include <tuple>
+#include <utility>
 #include <vector>
 
 #include "../../core/Logger.h"
+#include "../../threading/JobSystem.h"
 #include "../../utils/math/Mth.h"
 #include "../block/Block.h"
+#include "../block/BlockProperties.h"
 #include "../chunk/Chunk.h"
+#include "../chunk/RegionView.h"
 
 static constexpr int DIRECTIONS[6][3] = {{1, 0, 0},  {-1, 0, 0}, {0, 1, 0},
                                          {0, -1, 0}, {0, 0, 1},  {0, 0, -1}};
@@ -69,24 +74,36 @@ struct FastQueue
 
 struct LightChunkCache
 {
-    std::unordered_map<ChunkPos, Chunk *, ChunkPosHash> m_map;
     Level *m_level;
+    ChunkPos m_lastPos;
+    Chunk *m_last;
 
-    explicit LightChunkCache(Level *level) : m_level(level) { m_map.reserve(64); }
+    explicit LightChunkCache(Level *level) : m_level(level), m_lastPos(), m_last(nullptr) {}
 
     Chunk *get(const ChunkPos &p)
     {
-        auto it = m_map.find(p);
-        if (it != m_map.end())
+        if (m_last && p == m_lastPos)
         {
-            return it->second;
+            return m_last;
         }
-        Chunk *chunk = m_level->getChunk(p);
-        m_map[p]     = chunk;
-        return chunk;
+        m_last    = m_level->getChunk(p);
+        m_lastPos = p;
+        return m_last;
     }
 };
 
+struct LightUpdateScratch
+{
+    std::vector<BlockPos> positions;
+    std::vector<bool> dirtyColumns;
+    FastQueue<LightRemovalNode> skyRemovalQueue;
+    FastQueue<LightEngine::SkyLightNode> skyAddQueue;
+    FastQueue<ColoredLightRemovalNode> blockRemovalQueue;
+    FastQueue<LightEngine::LightNode> blockAddQueue;
+};
+
+static thread_local LightUpdateScratch s_updateScratch;
+
 static inline int chunkCoord(int w, int size) { return Mth::floorDiv(w, size); }
 
 static inline int localCoord(int w, int size) { return Mth::floorMod(w, size); }
@@ -98,12 +115,21 @@ void LightEngine::rebuildChunk(Level *level, const ChunkPos &pos)
         return;
     }
 
+    std::unique_lock<std::shared_mutex> lock = level->getDimension()->lockLightWrites();
+
     Chunk *chunk = level->getChunk(pos);
     if (!chunk)
     {
         return;
     }
 
+    clearChunk(chunk);
+    propagateSkyLight(level, pos);
+    propagateBlockLight(level, pos);
+}
+
+void LightEngine::clearChunk(Chunk *chunk)
+{
     for (int y = 0; y < Chunk::SIZE_Y; y++)
     {
         for (int z = 0; z < Chunk::SIZE_Z; z++)
@@ -115,9 +141,6 @@ void LightEngine::rebuildChunk(Level *level, const ChunkPos &pos)
             }
         }
     }
-
-    propagateSkyLight(level, pos);
-    propagateBlockLight(level, pos);
 }
 
 void LightEngine::propagateSkyLight(Level *level, const ChunkPos &pos)
@@ -129,7 +152,6 @@ void LightEngine::propagateSkyLight(Level *level, const ChunkPos &pos)
     }
 
     LightChunkCache cache(level);
-    cache.m_map[pos] = chunk;
 
     FastQueue<SkyLightNode> lightQueue;
     lightQueue.reserve(Chunk::SIZE_X * Chunk::SIZE_Z * 16);
@@ -143,8 +165,7 @@ void LightEngine::propagateSkyLight(Level *level, const ChunkPos &pos)
 
             for (int y = Chunk::SIZE_Y - 1; y >= 0; y--)
             {
-                Block *block = Block::byId(chunk->getBlockId(x, y, z));
-                if (block->isSolid())
+                if (BlockProperties::isSolid(chunk->getBlockId(x, y, z)))
                     break;
 
                 chunk->setSkyLight(x, y, z, 15);
@@ -198,8 +219,7 @@ void LightEngine::propagateSkyLight(Level *level, const ChunkPos &pos)
             int lx = localCoord(nx, Chunk::SIZE_X);
             int lz = localCoord(nz, Chunk::SIZE_Z);
 
-            Block *neighborBlock = Block::byId(neighborChunk->getBlockId(lx, ny, lz));
-            if (neighborBlock->isSolid())
+            if (BlockProperties::isSolid(neighborChunk->getBlockId(lx, ny, lz)))
             {
                 continue;
             }
@@ -232,7 +252,6 @@ void LightEngine::propagateBlockLight(Level *level, const ChunkPos &pos)
         return;
 
     LightChunkCache cache(level);
-    cache.m_map[pos] = chunk;
 
     FastQueue<LightNode> lightQueue;
     lightQueue.reserve(Chunk::SIZE_X * Chunk::SIZE_Z * 16);
@@ -243,8 +262,8 @@ void LightEngine::propagateBlockLight(Level *level, const ChunkPos &pos)
         {
             for (int x = 0; x < Chunk::SIZE_X; x++)
             {
-                Block *block     = Block::byId(chunk->getBlockId(x, y, z));
-                uint8_t emission = block->getLightEmission();
+                uint32_t id      = chunk->getBlockId(x, y, z);
+                uint8_t emission = BlockProperties::getLightEmission(id);
                 if (emission == 0)
                 {
                     continue;
@@ -253,7 +272,7 @@ void LightEngine::propagateBlockLight(Level *level, const ChunkPos &pos)
                 uint8_t lr;
                 uint8_t lg;
                 uint8_t lb;
-                block->getLightColor(&lr, &lg, &lb);
+                BlockProperties::getLightColor(id, &lr, &lg, &lb);
 
                 uint8_t finalR = (uint8_t) ((lr / 255.0f) * emission);
                 uint8_t finalG = (uint8_t) ((lg / 255.0f) * emission);
@@ -319,8 +338,7 @@ void LightEngine::propagateBlockLight(Level *level, const ChunkPos &pos)
             int lx = localCoord(nx, Chunk::SIZE_X);
             int lz = localCoord(nz, Chunk::SIZE_Z);
 
-            Block *neighborBlock = Block::byId(neighborChunk->getBlockId(lx, ny, lz));
-            if (neighborBlock->isSolid())
+            if (BlockProperties::isSolid(neighborChunk->getBlockId(lx, ny, lz)))
             {
                 continue;
             }
@@ -353,16 +371,42 @@ void LightEngine::rebuild(Level *level)
         return;
     }
 
-    const auto &chunks = level->getChunks();
-    for (const auto &[pos, chunk] : chunks)
+    std::unique_lock<std::shared_mutex> lock = level->getDimension()->lockLightWrites();
+
+    std::vector<std::pair<ChunkPos, Chunk *>> chunks;
+    for (const auto &[pos, chunk] : level->getChunks())
     {
-        if (!chunk)
+        if (chunk)
         {
-            continue;
+            chunks.emplace_back(ChunkPos(pos.x, pos.y, pos.z), chunk.get());
         }
+    }
 
-        ChunkPos chunkPos(pos.x, pos.y, pos.z);
-        rebuildChunk(level, chunkPos);
+    JobSystem *jobs = JobSystem::get();
+    jobs->parallelFor(JobClass::LIGHTING, 0, chunks.size(), 4, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+        {
+            clearChunk(chunks[i].second);
+        }
+    });
+
+    std::vector<ChunkPos> passes[REBUILD_PASS_STRIDE * REBUILD_PASS_STRIDE];
+    for (const auto &[pos, chunk] : chunks)
+    {
+        int px = Mth::floorMod(pos.x, REBUILD_PASS_STRIDE);
+        int pz = Mth::floorMod(pos.z, REBUILD_PASS_STRIDE);
+        passes[px + pz * REBUILD_PASS_STRIDE].push_back(pos);
+    }
+
+    for (const std::vector<ChunkPos> &pass : passes)
+    {
+        jobs->parallelFor(JobClass::LIGHTING, 0, pass.size(), 1, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++)
+            {
+                propagateSkyLight(level, pass[i]);
+                propagateBlockLight(level, pass[i]);
+            }
+        });
     }
 }
 
@@ -372,56 +416,125 @@ void LightEngine::updateFrom(Level *level, const BlockPos &levelPos)
     {
         return;
     }
-    if (levelPos.y < 0 || levelPos.y >= Chunk::SIZE_Y)
+
+    std::vector<ChunkPos> dirtyChunks;
+    updateFrom(level, std::vector<BlockPos>{levelPos}, &dirtyChunks);
+    for (const ChunkPos &pos : dirtyChunks)
+    {
+        level->markChunkDirtyUrgent(pos);
+    }
+}
+
+void LightEngine::updateFrom(Level *level, const std::vector<BlockPos> &levelPositions,
+                             std::vector<ChunkPos> *dirtyChunks)
+{
+    if (!level)
     {
         return;
     }
 
-    LightChunkCache cache(level);
-    std::unordered_set<ChunkPos, ChunkPosHash> dirtyChunks;
+    std::unique_lock<std::shared_mutex> lock = level->getDimension()->lockLightWrites();
 
-    FastQueue<LightRemovalNode> skyRemovalQueue;
-    FastQueue<SkyLightNode> skyAddQueue;
-    FastQueue<ColoredLightRemovalNode> blockRemovalQueue;
-    FastQueue<LightNode> blockAddQueue;
+    std::vector<BlockPos> &positions = s_updateScratch.positions;
+    positions.clear();
+    for (const BlockPos &levelPos : levelPositions)
+    {
+        if (levelPos.y >= 0 && levelPos.y < Chunk::SIZE_Y)
+        {
+            positions.push_back(levelPos);
+        }
+    }
 
-    skyRemovalQueue.reserve(512);
-    skyAddQueue.reserve(512);
-    blockRemovalQueue.reserve(512);
-    blockAddQueue.reserve(512);
+    auto batchKey = [](const BlockPos &pos) {
+        return std::make_tuple(pos.x >> UPDATE_BATCH_SHIFT, pos.z >> UPDATE_BATCH_SHIFT, pos.x,
+                               pos.z, pos.y);
+    };
+    std::sort(positions.begin(), positions.end(),
+              [&batchKey](const BlockPos &a, const BlockPos &b) {
+                  return batchKey(a) < batchKey(b);
+              });
+    positions.erase(std::unique(positions.begin(), positions.end()), positions.end());
+
+    size_t firstDirty = dirtyChunks->size();
+    for (size_t begin = 0; begin < positions.size();)
+    {
+        int cellX  = positions[begin].x >> UPDATE_BATCH_SHIFT;
+        int cellZ  = positions[begin].z >> UPDATE_BATCH_SHIFT;
+        size_t end = begin + 1;
+        while (end < positions.size() && positions[end].x >> UPDATE_BATCH_SHIFT == cellX &&
+               positions[end].z >> UPDATE_BATCH_SHIFT == cellZ)
+        {
+            end++;
+        }
 
-    int cx = chunkCoord(levelPos.x, Chunk::SIZE_X);
-    int cz = chunkCoord(levelPos.z, Chunk::SIZE_Z);
-    ChunkPos baseChunkPos(cx, 0, cz);
-    dirtyChunks.insert(baseChunkPos);
+        updateRegion(level, positions.data() + begin, positions.data() + end, dirtyChunks);
+        begin = end;
+    }
 
-    Block *changedBlock = nullptr;
+    std::sort(dirtyChunks->begin() + firstDirty, dirtyChunks->end(),
+              [](const ChunkPos &a, const ChunkPos &b) {
+                  return a.x != b.x ? a.x < b.x : a.z < b.z;
+              });
+    dirtyChunks->erase(std::unique(dirtyChunks->begin() + firstDirty, dirtyChunks->end()),
+                       dirtyChunks->end());
+}
 
+void LightEngine::updateRegion(Level *level, const BlockPos *begin, const BlockPos *end,
+                               std::vector<ChunkPos> *dirtyChunks)
+{
+    int minX = begin->x;
+    int minZ = begin->z;
+    int maxX = begin->x;
+    int maxZ = begin->z;
+    for (const BlockPos *levelPos = begin; levelPos != end; levelPos++)
     {
-        Chunk *chunk = cache.get(baseChunkPos);
-        if (chunk)
+        minX = std::min(minX, levelPos->x);
+        minZ = std::min(minZ, levelPos->z);
+        maxX = std::max(maxX, levelPos->x);
+        maxZ = std::max(maxZ, levelPos->z);
+    }
+
+    RegionView region(*level, minX - UPDATE_REGION_RADIUS, minZ - UPDATE_REGION_RADIUS,
+                      maxX + UPDATE_REGION_RADIUS, maxZ + UPDATE_REGION_RADIUS);
+
+    LightUpdateScratch &scratch = s_updateScratch;
+    scratch.dirtyColumns.assign(region.getColumnCount(), false);
+    scratch.skyRemovalQueue.clear();
+    scratch.skyAddQueue.clear();
+    scratch.blockRemovalQueue.clear();
+    scratch.blockAddQueue.clear();
+
+    std::vector<bool> &dirtyColumns                       = scratch.dirtyColumns;
+    FastQueue<LightRemovalNode> &skyRemovalQueue          = scratch.skyRemovalQueue;
+    FastQueue<SkyLightNode> &skyAddQueue                  = scratch.skyAddQueue;
+    FastQueue<ColoredLightRemovalNode> &blockRemovalQueue = scratch.blockRemovalQueue;
+    FastQueue<LightNode> &blockAddQueue                   = scratch.blockAddQueue;
+
+    for (const BlockPos *levelPos = begin; levelPos != end; levelPos++)
+    {
+        if (region.getChunk(levelPos->x, levelPos->z))
         {
-            int lx       = localCoord(levelPos.x, Chunk::SIZE_X);
-            int lz       = localCoord(levelPos.z, Chunk::SIZE_Z);
-            changedBlock = Block::byId(chunk->getBlockId(lx, levelPos.y, lz));
+            dirtyColumns[region.getColumnIndex(levelPos->x, levelPos->z)] = true;
         }
     }
 
+    for (const BlockPos *levelPos = begin; levelPos != end; levelPos++)
     {
-        Chunk *chunk = cache.get(baseChunkPos);
-        if (chunk)
+        Chunk *chunk = region.getChunk(levelPos->x, levelPos->z);
+        if (!chunk)
         {
-            int lx = localCoord(levelPos.x, Chunk::SIZE_X);
-            int lz = localCoord(levelPos.z, Chunk::SIZE_Z);
+            continue;
+        }
 
-            for (int y = levelPos.y; y < Chunk::SIZE_Y; y++)
+        int lx = levelPos->x & RegionView::LOCAL_MASK;
+        int lz = levelPos->z & RegionView::LOCAL_MASK;
+        for (int y = levelPos->y; y < Chunk::SIZE_Y; y++)
+        {
+            uint8_t oldLevel = chunk->getSkyLight(lx, y, lz);
+            if (oldLevel > 0)
             {
-                uint8_t oldLevel = chunk->getSkyLight(lx, y, lz);
-                if (oldLevel > 0)
-                {
-                    chunk->setSkyLight(lx, y, lz, 0);
-                    skyRemovalQueue.push({levelPos.x, y, levelPos.z, oldLevel});
-                }
+                chunk->setSkyLight(lx, y, lz, 0);
+                skyRemovalQueue.push({levelPos->x, y, levelPos->z, oldLevel});
             }
         }
     }
@@ -439,23 +552,18 @@ void LightEngine::updateFrom(Level *level, const BlockPos &levelPos)
             if (ny < 0 || ny >= Chunk::SIZE_Y)
                 continue;
 
-            int ncx = chunkCoord(nx, Chunk::SIZE_X);
-            int ncz = chunkCoord(nz, Chunk::SIZE_Z);
-
-            Chunk *neighborChunk = cache.get(ChunkPos(ncx, 0, ncz));
+            Chunk *neighborChunk = region.getChunk(nx, nz);
             if (!neighborChunk)
             {
                 continue;
             }
 
-            if (ncx != cx || ncz != cz)
-                dirtyChunks.insert(ChunkPos(ncx, 0, ncz));
+            dirtyColumns[region.getColumnIndex(nx, nz)] = true;
 
-            int lx = localCoord(nx, Chunk::SIZE_X);
-            int lz = localCoord(nz, Chunk::SIZE_Z);
+            int lx = nx & RegionView::LOCAL_MASK;
+            int lz = nz & RegionView::LOCAL_MASK;
 
-            Block *neighborBlock = Block::byId(neighborChunk->getBlockId(lx, ny, lz));
-            if (neighborBlock->isSolid())
+            if (BlockProperties::isSolid(neighborChunk->getBlockId(lx, ny, lz)))
             {
                 continue;
             }
@@ -488,17 +596,16 @@ void LightEngine::updateFrom(Level *level, const BlockPos &levelPos)
         }
     }
 
+    for (const BlockPos *levelPos = begin; levelPos != end; levelPos++)
     {
-        Chunk *chunk = cache.get(baseChunkPos);
-        if (chunk)
+        if (Chunk *chunk = region.getChunk(levelPos->x, levelPos->z))
         {
-            int lx = localCoord(levelPos.x, Chunk::SIZE_X);
-            int lz = localCoord(levelPos.z, Chunk::SIZE_Z);
+            int lx = levelPos->x & RegionView::LOCAL_MASK;
+            int lz = levelPos->z & RegionView::LOCAL_MASK;
 
             for (int y = Chunk::SIZE_Y - 1; y >= 0; y--)
             {
-                Block *block = Block::byId(chunk->getBlockId(lx, y, lz));
-                if (block->isSolid())
+                if (BlockProperties::isSolid(chunk->getBlockId(lx, y, lz)))
                 {
                     break;
                 }
@@ -507,39 +614,36 @@ void LightEngine::updateFrom(Level *level, const BlockPos &levelPos)
                 if (currentLevel < 15)
                 {
                     chunk->setSkyLight(lx, y, lz, 15);
-                    skyAddQueue.push({levelPos.x, y, levelPos.z, 15});
+                    skyAddQueue.push({levelPos->x, y, levelPos->z, 15});
                 }
             }
         }
-    }
 
-    for (int i = 0; i < 6; i++)
-    {
-        int nx = levelPos.x + DIRECTIONS[i][0];
-        int ny = levelPos.y + DIRECTIONS[i][1];
-        int nz = levelPos.z + DIRECTIONS[i][2];
-
-        if (ny < 0 || ny >= Chunk::SIZE_Y)
+        for (int i = 0; i < 6; i++)
         {
-            continue;
-        }
+            int nx = levelPos->x + DIRECTIONS[i][0];
+            int ny = levelPos->y + DIRECTIONS[i][1];
+            int nz = levelPos->z + DIRECTIONS[i][2];
 
-        int ncx = chunkCoord(nx, Chunk::SIZE_X);
-        int ncz = chunkCoord(nz, Chunk::SIZE_Z);
+            if (ny < 0 || ny >= Chunk::SIZE_Y)
+            {
+                continue;
+            }
 
-        Chunk *neighborChunk = cache.get(ChunkPos(ncx, 0, ncz));
-        if (!neighborChunk)
-        {
-            continue;
-        }
+            Chunk *neighborChunk = region.getChunk(nx, nz);
+            if (!neighborChunk)
+            {
+                continue;
+            }
 
-        int lx = localCoord(nx, Chunk::SIZE_X);
-        int lz = localCoord(nz, Chunk::SIZE_Z);
+            int lx = nx & RegionView::LOCAL_MASK;
+            int lz = nz & RegionView::LOCAL_MASK;
 
-        uint8_t neighborLevel = neighborChunk->getSkyLight(lx, ny, lz);
-        if (neighborLevel > 0)
-        {
-            skyAddQueue.push({nx, ny, nz, neighborLevel});
+            uint8_t neighborLevel = neighborChunk->getSkyLight(lx, ny, lz);
+            if (neighborLevel > 0)
+            {
+                skyAddQueue.push({nx, ny, nz, neighborLevel});
+            }
         }
     }
 
@@ -548,12 +652,10 @@ void LightEngine::updateFrom(Level *level, const BlockPos &levelPos)
         SkyLightNode node = skyAddQueue.front();
         skyAddQueue.pop();
 
-        int ncx0 = chunkCoord(node.x, Chunk::SIZE_X);
-        int ncz0 = chunkCoord(node.z, Chunk::SIZE_Z);
-        int lx0  = localCoord(node.x, Chunk::SIZE_X);
-        int lz0  = localCoord(node.z, Chunk::SIZE_Z);
+        int lx0 = node.x & RegionView::LOCAL_MASK;
+        int lz0 = node.z & RegionView::LOCAL_MASK;
 
-        Chunk *nodeChunk = cache.get(ChunkPos(ncx0, 0, ncz0));
+        Chunk *nodeChunk = region.getChunk(node.x, node.z);
         if (!nodeChunk)
         {
             continue;
@@ -575,23 +677,18 @@ void LightEngine::updateFrom(Level *level, const BlockPos &levelPos)
                 continue;
             }
 
-            int ncx = chunkCoord(nx, Chunk::SIZE_X);
-            int ncz = chunkCoord(nz, Chunk::SIZE_Z);
-
-            Chunk *neighborChunk = cache.get(ChunkPos(ncx, 0, ncz));
+            Chunk *neighborChunk = region.getChunk(nx, nz);
             if (!neighborChunk)
             {
                 continue;
             }
 
-            if (ncx != cx || ncz != cz)
-                dirtyChunks.insert(ChunkPos(ncx, 0, ncz));
+            dirtyColumns[region.getColumnIndex(nx, nz)] = true;
 
-            int lx = localCoord(nx, Chunk::SIZE_X);
-            int lz = localCoord(nz, Chunk::SIZE_Z);
+            int lx = nx & RegionView::LOCAL_MASK;
+            int lz = nz & RegionView::LOCAL_MASK;
 
-            Block *neighborBlock = Block::byId(neighborChunk->getBlockId(lx, ny, lz));
-            if (neighborBlock->isSolid())
+            if (BlockProperties::isSolid(neighborChunk->getBlockId(lx, ny, lz)))
             {
                 continue;
             }
@@ -616,22 +713,25 @@ void LightEngine::updateFrom(Level *level, const BlockPos &levelPos)
         }
     }
 
+    for (const BlockPos *levelPos = begin; levelPos != end; levelPos++)
     {
-        Chunk *chunk = cache.get(baseChunkPos);
-        if (chunk)
+        Chunk *chunk = region.getChunk(levelPos->x, levelPos->z);
+        if (!chunk)
         {
-            int lx = localCoord(levelPos.x, Chunk::SIZE_X);
-            int lz = localCoord(levelPos.z, Chunk::SIZE_Z);
-            uint8_t oldR;
-            uint8_t oldG;
-            uint8_t oldB;
-            chunk->getBlockLight(lx, levelPos.y, lz, &oldR, &oldG, &oldB);
+            continue;
+        }
 
-            if (oldR > 0 || oldG > 0 || oldB > 0)
-            {
-                chunk->setBlockLight(lx, levelPos.y, lz, 0, 0, 0);
-                blockRemovalQueue.push({levelPos.x, levelPos.y, levelPos.z, oldR, oldG, oldB});
-            }
+        int lx = levelPos->x & RegionView::LOCAL_MASK;
+        int lz = levelPos->z & RegionView::LOCAL_MASK;
+        uint8_t oldR;
+        uint8_t oldG;
+        uint8_t oldB;
+        chunk->getBlockLight(lx, levelPos->y, lz, &oldR, &oldG, &oldB);
+
+        if (oldR > 0 || oldG > 0 || oldB > 0)
+        {
+            chunk->setBlockLight(lx, levelPos->y, lz, 0, 0, 0);
+            blockRemovalQueue.push({levelPos->x, levelPos->y, levelPos->z, oldR, oldG, oldB});
         }
     }
 
@@ -650,24 +750,18 @@ void LightEngine::updateFrom(Level *level, const BlockPos &levelPos)
                 continue;
             }
 
-            int ncx              = chunkCoord(nx, Chunk::SIZE_X);
-            int ncz              = chunkCoord(nz, Chunk::SIZE_Z);
-            Chunk *neighborChunk = cache.get(ChunkPos(ncx, 0, ncz));
+            Chunk *neighborChunk = region.getChunk(nx, nz);
             if (!neighborChunk)
             {
                 continue;
             }
 
-            if (ncx != cx || ncz != cz)
-            {
-                dirtyChunks.insert(ChunkPos(ncx, 0, ncz));
-            }
+            dirtyColumns[region.getColumnIndex(nx, nz)] = true;
 
-            int lx = localCoord(nx, Chunk::SIZE_X);
-            int lz = localCoord(nz, Chunk::SIZE_Z);
+            int lx = nx & RegionView::LOCAL_MASK;
+            int lz = nz & RegionView::LOCAL_MASK;
 
-            Block *neighborBlock = Block::byId(neighborChunk->getBlockId(lx, ny, lz));
-            if (neighborBlock->isSolid())
+            if (BlockProperties::isSolid(neighborChunk->getBlockId(lx, ny, lz)))
             {
                 continue;
             }
@@ -712,53 +806,57 @@ void LightEngine::updateFrom(Level *level, const BlockPos &levelPos)
         }
     }
 
-    if (changedBlock && changedBlock->getLightEmission() > 0)
+    for (const BlockPos *levelPos = begin; levelPos != end; levelPos++)
     {
-        uint8_t emission = changedBlock->getLightEmission();
-        uint8_t lr;
-        uint8_t lg;
-        uint8_t lb;
-        changedBlock->getLightColor(&lr, &lg, &lb);
-
-        uint8_t finalR = (uint8_t) ((lr / 255.0f) * emission);
-        uint8_t finalG = (uint8_t) ((lg / 255.0f) * emission);
-        uint8_t finalB = (uint8_t) ((lb / 255.0f) * emission);
+        Chunk *chunk = region.getChunk(levelPos->x, levelPos->z);
+        if (!chunk)
+        {
+            continue;
+        }
 
-        Chunk *chunk = cache.get(baseChunkPos);
-        if (chunk)
+        int lx0            = levelPos->x & RegionView::LOCAL_MASK;
+        int lz0            = levelPos->z & RegionView::LOCAL_MASK;
+        uint32_t changedId = chunk->getBlockId(lx0, levelPos->y, lz0);
+        uint8_t emission   = BlockProperties::getLightEmission(changedId);
+        if (emission > 0)
         {
-            int lx = localCoord(levelPos.x, Chunk::SIZE_X);
-            int lz = localCoord(levelPos.z, Chunk::SIZE_Z);
-            chunk->setBlockLight(lx, levelPos.y, lz, finalR, finalG, finalB);
+            uint8_t lr;
+            uint8_t lg;
+            uint8_t lb;
+            BlockProperties::getLightColor(changedId, &lr, &lg, &lb);
+
+            uint8_t finalR = (uint8_t) ((lr / 255.0f) * emission);
+            uint8_t finalG = (uint8_t) ((lg / 255.0f) * emission);
+            uint8_t finalB = (uint8_t) ((lb / 255.0f) * emission);
+
+            chunk->setBlockLight(lx0, levelPos->y, lz0, finalR, finalG, finalB);
+            blockAddQueue.push({levelPos->x, levelPos->y, levelPos->z, finalR, finalG, finalB});
         }
 
-        blockAddQueue.push({levelPos.x, levelPos.y, levelPos.z, finalR, finalG, finalB});
-    }
+        if (BlockProperties::isSolid(changedId))
+        {
+            continue;
+        }
 
-    if (changedBlock && !changedBlock->isSolid())
-    {
         for (int i = 0; i < 6; i++)
         {
-            int nx = levelPos.x + DIRECTIONS[i][0];
-            int ny = levelPos.y + DIRECTIONS[i][1];
-            int nz = levelPos.z + DIRECTIONS[i][2];
+            int nx = levelPos->x + DIRECTIONS[i][0];
+            int ny = levelPos->y + DIRECTIONS[i][1];
+            int nz = levelPos->z + DIRECTIONS[i][2];
             if (ny < 0 || ny >= Chunk::SIZE_Y)
             {
                 continue;
             }
 
-            int ncx              = chunkCoord(nx, Chunk::SIZE_X);
-            int ncz              = chunkCoord(nz, Chunk::SIZE_Z);
-            Chunk *neighborChunk = cache.get(ChunkPos(ncx, 0, ncz));
+            Chunk *neighborChunk = region.getChunk(nx, nz);
             if (!neighborChunk)
             {
                 continue;
             }
 
-            int lx               = localCoord(nx, Chunk::SIZE_X);
-            int lz               = localCoord(nz, Chunk::SIZE_Z);
-            Block *neighborBlock = Block::byId(neighborChunk->getBlockId(lx, ny, lz));
-            if (neighborBlock->isSolid())
+            int lx = nx & RegionView::LOCAL_MASK;
+            int lz = nz & RegionView::LOCAL_MASK;
+            if (BlockProperties::isSolid(neighborChunk->getBlockId(lx, ny, lz)))
             {
                 continue;
             }
@@ -780,12 +878,10 @@ void LightEngine::updateFrom(Level *level, const BlockPos &levelPos)
         LightNode node = blockAddQueue.front();
         blockAddQueue.pop();
 
-        int ncx0 = chunkCoord(node.x, Chunk::SIZE_X);
-        int ncz0 = chunkCoord(node.z, Chunk::SIZE_Z);
-        int lx0  = localCoord(node.x, Chunk::SIZE_X);
-        int lz0  = localCoord(node.z, Chunk::SIZE_Z);
+        int lx0 = node.x & RegionView::LOCAL_MASK;
+        int lz0 = node.z & RegionView::LOCAL_MASK;
 
-        Chunk *nodeChunk = cache.get(ChunkPos(ncx0, 0, ncz0));
+        Chunk *nodeChunk = region.getChunk(node.x, node.z);
         if (!nodeChunk)
         {
             continue;
@@ -812,24 +908,18 @@ void LightEngine::updateFrom(Level *level, const BlockPos &levelPos)
                 continue;
             }
 
-            int ncx              = chunkCoord(nx, Chunk::SIZE_X);
-            int ncz              = chunkCoord(nz, Chunk::SIZE_Z);
-            Chunk *neighborChunk = cache.get(ChunkPos(ncx, 0, ncz));
+            Chunk *neighborChunk = region.getChunk(nx, nz);
             if (!neighborChunk)
             {
                 continue;
             }
 
-            if (ncx != cx || ncz != cz)
-            {
-                dirtyChunks.insert(ChunkPos(ncx, 0, ncz));
-            }
+            dirtyColumns[region.getColumnIndex(nx, nz)] = true;
 
-            int lx = localCoord(nx, Chunk::SIZE_X);
-            int lz = localCoord(nz, Chunk::SIZE_Z);
+            int lx = nx & RegionView::LOCAL_MASK;
+            int lz = nz & RegionView::LOCAL_MASK;
 
-            Block *neighborBlock = Block::byId(neighborChunk->getBlockId(lx, ny, lz));
-            if (neighborBlock->isSolid())
+            if (BlockProperties::isSolid(neighborChunk->getBlockId(lx, ny, lz)))
             {
                 continue;
             }
@@ -854,7 +944,13 @@ void LightEngine::updateFrom(Level *level, const BlockPos &levelPos)
         }
     }
 
-    for (const ChunkPos &chunkPos : dirtyChunks) level->markChunkDirtyUrgent(chunkPos);
+    for (size_t i = 0; i < dirtyColumns.size(); i++)
+    {
+        if (dirtyColumns[i])
+        {
+            dirtyChunks->push_back(region.getColumnPos(i));
+        }
+    }
 }
 
 void LightEngine::getBlockLight(Level *level, const BlockPos &levelPos, uint8_t *r, uint8_t *g,
@@ -898,6 +994,9 @@ void LightEngine::setBlockLight(Level *level, const BlockPos &levelPos, uint8_t
     int cz = chunkCoord(levelPos.z, Chunk::SIZE_Z);
 
     ChunkPos chunkPos(cx, 0, cz);
+
+    std::unique_lock<std::shared_mutex> lock = level->getDimension()->lockLightWrites();
+
     Chunk *chunk = level->getChunk(chunkPos);
     if (!chunk)
     {
@@ -941,6 +1040,9 @@ void LightEngine::setSkyLight(Level *level, const BlockPos &levelPos, uint8_t li
     int cx = chunkCoord(levelPos.x, Chunk::SIZE_X);
     int cz = chunkCoord(levelPos.z, Chunk::SIZE_Z);
     ChunkPos chunkPos(cx, 0, cz);
+
+    std::unique_lock<std::shared_mutex> lock = level->getDimension()->lockLightWrites();
+
     Chunk *chunk = level->getChunk(chunkPos);
     if (!chunk)
     {
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <vector>
 
 #include "../Level.h"
 #include "../chunk/ChunkPos.h"
@@ -29,6 +30,8 @@ public:
     static void rebuild(Level *level);
     static void rebuildChunk(Level *level, const ChunkPos &pos);
     static void updateFrom(Level *level, const BlockPos &levelPos);
+    static void updateFrom(Level *level, const std::vector<BlockPos> &levelPositions,
+                           std::vector<ChunkPos> *dirtyChunks);
 
     static void setBlockLight(Level *level, const BlockPos &levelPos, uint8_t r, uint8_t g,
                               uint8_t b);
@@ -42,6 +45,13 @@ public:
                               uint8_t *b);
 
 private:
+    static constexpr int REBUILD_PASS_STRIDE  = 3;
+    static constexpr int UPDATE_REGION_RADIUS = 31;
+    static constexpr int UPDATE_BATCH_SHIFT   = 6;
+
+    static void clearChunk(Chunk *chunk);
     static void propagateSkyLight(Level *level, const ChunkPos &pos);
     static void propagateBlockLight(Level *level, const ChunkPos &pos);
+    static void updateRegion(Level *level, const BlockPos *begin, const BlockPos *end,
+                             std::vector<ChunkPos> *dirtyChunks);
 };
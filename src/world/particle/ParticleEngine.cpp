@@ -2,7 +2,7 @@
 
 #include <algorithm>
 
-#include "../../threading/ThreadStorage.h"
+#include "../../threading/JobSystem.h"
 #include "../../utils/Random.h"
 #include "../../utils/math/Mth.h"
 #include "ParticleRegistry.h"
@@ -23,24 +23,15 @@ static Vec3 randomSpread(Random *random, const Vec3 &spread)
                 randomCentered(random, spread.z));
 }
 
-ParticleEngine::ParticleEngine()
-    : m_pool(std::make_unique<ThreadPool>(1)), m_updateRunning(false), m_updateReady(false)
-{}
+ParticleEngine::ParticleEngine() : m_updateRunning(false), m_completed(2) {}
 
-ParticleEngine::~ParticleEngine()
-{
-    if (m_pool)
-    {
-        m_pool->wait();
-        m_pool.reset();
-    }
-}
+ParticleEngine::~ParticleEngine() { JobSystem::get()->waitForClass(JobClass::SIMULATION); }
 
 void ParticleEngine::tick(float delta)
 {
     applyCompletedUpdate();
 
-    if (!m_pool || m_updateRunning.load())
+    if (m_updateRunning.load())
     {
         return;
     }
@@ -66,22 +57,16 @@ void ParticleEngine::tick(float delta)
 
     m_updateRunning.store(true);
 
-    m_pool->detachTask(
+    JobSystem::get()->submit(
+            JobClass::SIMULATION,
             [this, delta, particles = std::move(particles), spawns = std::move(spawns)]() mutable {
-                ThreadStorage::useDefaultThreadStorage();
                 spawnParticles(spawns, &particles);
                 updateParticles(delta, &particles);
 
                 std::vector<RenderParticle> renderParticles;
                 buildRenderParticles(particles, &renderParticles);
 
-                {
-                    std::lock_guard<std::mutex> lock(m_completedMutex);
-                    m_completedParticles       = std::move(particles);
-                    m_completedRenderParticles = std::move(renderParticles);
-                }
-
-                m_updateReady.store(true);
+                m_completed.push({std::move(particles), std::move(renderParticles)});
                 m_updateRunning.store(false);
             });
 }
@@ -114,19 +99,15 @@ size_t ParticleEngine::getParticleCount() const
 
 void ParticleEngine::applyCompletedUpdate()
 {
-    if (!m_updateReady.load())
+    CompletedUpdate update;
+    if (!m_completed.tryPop(&update))
     {
         return;
     }
 
-    {
-        std::lock_guard<std::mutex> completedLock(m_completedMutex);
-        std::lock_guard<std::mutex> stateLock(m_stateMutex);
-        m_particles       = std::move(m_completedParticles);
-        m_renderParticles = std::move(m_completedRenderParticles);
-    }
-
-    m_updateReady.store(false);
+    std::lock_guard<std::mutex> lock(m_stateMutex);
+    m_particles       = std::move(update.particles);
+    m_renderParticles = std::move(update.renderParticles);
 }
 
 void ParticleEngine::spawnParticles(const std::vector<ParticleSpawnParams> &spawns,
@@ -5,7 +5,7 @@
 #include <mutex>
 #include <vector>
 
-#include "../../threading/ThreadPool.h"
+#include "../../threading/MpscQueue.h"
 #include "../../utils/math/Vec3.h"
 #include "ParticleSpawnParams.h"
 
@@ -51,6 +51,12 @@ private:
         bool collides;
     };
 
+    struct CompletedUpdate
+    {
+        std::vector<Particle> particles;
+        std::vector<RenderParticle> renderParticles;
+    };
+
     void applyCompletedUpdate();
     void spawnParticles(const std::vector<ParticleSpawnParams> &spawns,
                         std::vector<Particle> *particles) const;
@@ -58,17 +64,13 @@ private:
     void buildRenderParticles(const std::vector<Particle> &particles,
                               std::vector<RenderParticle> *renderParticles) const;
 
-    std::unique_ptr<ThreadPool> m_pool;
     std::atomic<bool> m_updateRunning;
-    std::atomic<bool> m_updateReady;
 
     mutable std::mutex m_stateMutex;
-    mutable std::mutex m_completedMutex;
 
     std::vector<Particle> m_particles;
     std::vector<RenderParticle> m_renderParticles;
     std::vector<ParticleSpawnParams> m_pendingSpawns;
 
-    std::vector<Particle> m_completedParticles;
-    std::vector<RenderParticle> m_completedRenderParticles;
+    MpscQueue<CompletedUpdate> m_completed;
 };